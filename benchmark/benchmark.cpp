@@ -0,0 +1,92 @@
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "stp.hpp"
+
+using namespace stp;
+
+const std::size_t elements = 10000000;
+const int repetitions = 20;
+
+//Prevents the compiler from discarding the results being timed
+volatile double sink;
+
+//The fastest of several calls, in milliseconds, which is less affected by other load on the machine than the mean
+template <typename Function>
+double time_ms(const Function &fn)
+{
+    double best = 0;
+    for(int i = 0; i < repetitions; ++i)
+    {
+        auto start = std::chrono::steady_clock::now();
+        sink = static_cast<double>(fn());
+        double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        if(i == 0 || elapsed < best)
+        {
+            best = elapsed;
+        }
+    }
+
+    return best;
+}
+
+void report(const std::string &name, const double &scalar, const double &vectorized)
+{
+    std::cout << std::left << std::setw(16) << name
+              << std::right << std::fixed << std::setprecision(2)
+              << std::setw(10) << scalar << " ms"
+              << std::setw(10) << vectorized << " ms"
+              << std::setw(9) << scalar / vectorized << "x"
+              << std::endl;
+}
+
+//Compares the vectorized reductions on a std::vector against the same reductions written with the
+//standard algorithms, which process one element at a time
+template <typename ValueType>
+void run(const std::string &type)
+{
+    std::vector<ValueType> values(elements);
+    for(std::size_t i = 0; i < values.size(); ++i)
+    {
+        values[i] = static_cast<ValueType>(i % 1000);
+    }
+
+    report(type + " sum",
+           time_ms([&](){return std::accumulate(values.begin(), values.end(), ValueType(), std::plus<ValueType>());}),
+           time_ms([&](){return sum()(values);}));
+
+    report(type + " min",
+           time_ms([&](){return *std::min_element(values.begin(), values.end());}),
+           time_ms([&](){return min()(values);}));
+
+    report(type + " max",
+           time_ms([&](){return *std::max_element(values.begin(), values.end());}),
+           time_ms([&](){return max()(values);}));
+
+    report(type + " count",
+           time_ms([&](){return std::count(values.begin(), values.end(), ValueType(3));}),
+           time_ms([&](){return count(ValueType(3))(values);}));
+}
+
+int main()
+{
+    std::cout << "Best of " << repetitions << " runs over " << elements << " elements" << std::endl;
+    std::cout << std::left << std::setw(16) << "operation"
+              << std::right << std::setw(13) << "scalar"
+              << std::setw(13) << "vectorized"
+              << std::setw(10) << "speedup"
+              << std::endl;
+
+    run<int>("int");
+    run<float>("float");
+    run<double>("double");
+
+    return 0;
+}
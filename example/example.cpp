@@ -33,7 +33,7 @@ int main()
               << avg_balance(accts)
               << std::endl;
 
-    auto is_above_avg = [&](account i){return i.acct_balance > avg_balance(accts);};
+    auto is_above_avg = bind(avg_balance, [](double avg, account i){return i.acct_balance > avg;});
     auto is_eve = [](account i){return i.acct_holder == "Eve";};
     auto eve_above_avg = make_stp( where(is_above_avg), any(is_eve) );
 
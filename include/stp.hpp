@@ -2,7 +2,13 @@
 #define STP_HPP
 
 //Transformations
+#include "stp/incremental.hpp"
+#include "stp/memoize.hpp"
 #include "stp/pipeline.hpp"
+#include "stp/staged.hpp"
+
+//Tags
+#include "stp/tags.hpp"
 
 //Boolean reductions
 #include "stp/bool_reductions/all.hpp"
@@ -12,6 +18,7 @@
 
 //Filters
 #include "stp/filters/drop.hpp"
+#include "stp/filters/parallel_where.hpp"
 #include "stp/filters/take.hpp"
 #include "stp/filters/where.hpp"
 
@@ -20,27 +27,47 @@
 #include "stp/generators/repeat.hpp"
 
 //Miscellaneous
+#include "stp/misc/batch.hpp"
+#include "stp/misc/bind.hpp"
+#include "stp/misc/columns.hpp"
+#include "stp/misc/fixed_vector.hpp"
 #include "stp/misc/map.hpp"
+#include "stp/misc/parallel_map.hpp"
 #include "stp/misc/stl.hpp"
 #include "stp/misc/unique.hpp"
 #include "stp/misc/zip.hpp"
 
 //Numerical reductions
+#include "stp/num_reductions/approx_distinct.hpp"
 #include "stp/num_reductions/avg.hpp"
 #include "stp/num_reductions/count.hpp"
 #include "stp/num_reductions/fold.hpp"
 #include "stp/num_reductions/max.hpp"
 #include "stp/num_reductions/min.hpp"
+#include "stp/num_reductions/parallel_reduce.hpp"
+#include "stp/num_reductions/quantile.hpp"
+#include "stp/num_reductions/reduce_all.hpp"
 #include "stp/num_reductions/size.hpp"
+#include "stp/num_reductions/stats.hpp"
 #include "stp/num_reductions/sum.hpp"
 
 //Order operations
+#include "stp/order/external_sort.hpp"
+#include "stp/order/parallel_sort.hpp"
 #include "stp/order/reverse.hpp"
 #include "stp/order/sort.hpp"
+#include "stp/order/top_k.hpp"
 
 //Set operations
 #include "stp/set/difference.hpp"
 #include "stp/set/intersect.hpp"
 #include "stp/set/join.hpp"
+#include "stp/set/set_difference.hpp"
+#include "stp/set/set_intersect.hpp"
+#include "stp/set/set_union.hpp"
+
+//Window operations
+#include "stp/window/time_window.hpp"
+#include "stp/window/window.hpp"
 
 #endif
\ No newline at end of file
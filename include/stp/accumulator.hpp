@@ -0,0 +1,73 @@
+#ifndef STP_ACCUMULATOR_HPP
+#define STP_ACCUMULATOR_HPP
+
+#include <cstddef>
+
+namespace stp
+{
+    namespace detail
+    {
+        //An accumulator consumes a sequence one element at a time through
+        //push() and produces the same value as the reduction through result().
+        //Reductions which can be evaluated this way specialize it for their
+        //function object type.
+        template
+        <
+            typename OpType,
+            typename ValueType
+        >
+        struct accumulator;
+
+        //An accumulator which can also remove a previously pushed element
+        //through pop(). Invertible reductions specialize it, which lets
+        //sliding windows update their result in constant time.
+        template
+        <
+            typename OpType,
+            typename ValueType
+        >
+        struct reversible_accumulator
+        {
+            static const bool value = false;
+        };
+
+        //An accumulator which can also absorb another accumulator of the same
+        //reduction through merge(other), as if the other's elements had been
+        //pushed after its own. Reductions whose partial results combine this
+        //way specialize it, which lets parallel reductions split a sequence.
+        template
+        <
+            typename OpType,
+            typename ValueType
+        >
+        struct mergeable_accumulator
+        {
+            static const bool value = false;
+        };
+
+        //An element-wise operation processes a sequence one element at a
+        //time, passing zero or more results on through apply(op, val, next).
+        //output_type<ValueType> is the type of the results. Operations which
+        //can be evaluated this way specialize it for their function object type.
+        template <typename OpType>
+        struct element_op;
+
+        template <std::size_t ...I>
+        struct index_sequence {};
+
+        template
+        <
+            std::size_t N,
+            std::size_t ...I
+        >
+        struct make_index_sequence : make_index_sequence<N - 1, N - 1, I...> {};
+
+        template <std::size_t ...I>
+        struct make_index_sequence<0, I...>
+        {
+            using type = index_sequence<I...>;
+        };
+    }
+}
+
+#endif
@@ -5,6 +5,8 @@
 #include <iterator>
 #include <type_traits>
 
+#include "../accumulator.hpp"
+
 namespace stp
 {
     namespace detail
@@ -12,7 +14,7 @@ namespace stp
         template <typename Predicate>
         struct any_type
         {
-            any_type(const Predicate &pred) : pred_(pred) {}
+            constexpr any_type(const Predicate &pred) : pred_(pred) {}
 
             template
             <
@@ -28,10 +30,35 @@ namespace stp
 
             Predicate pred_;
         };
+
+        template
+        <
+            typename Predicate,
+            typename ValueType
+        >
+        struct accumulator<any_type<Predicate>, ValueType>
+        {
+            using result_type = bool;
+
+            accumulator(const any_type<Predicate> &op) : pred_(op.pred_), acc_(false) {}
+
+            void push(const ValueType &val)
+            {
+                acc_ = acc_ || pred_(val);
+            }
+
+            result_type result() const
+            {
+                return acc_;
+            }
+
+            Predicate pred_;
+            bool acc_;
+        };
     }
 
     template <typename Predicate>
-    detail::any_type<Predicate> any(const Predicate &pred)
+    constexpr detail::any_type<Predicate> any(const Predicate &pred)
     {
         return detail::any_type<Predicate>(pred);
     }
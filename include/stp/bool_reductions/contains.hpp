@@ -5,6 +5,8 @@
 #include <iterator>
 #include <type_traits>
 
+#include "../accumulator.hpp"
+
 namespace stp
 {
     namespace detail
@@ -12,7 +14,7 @@ namespace stp
         template <typename ElementType>
         struct contains_type
         {
-            contains_type(const ElementType &val) : val_(val) {}
+            constexpr contains_type(const ElementType &val) : val_(val) {}
 
             template
             <
@@ -30,10 +32,35 @@ namespace stp
 
             ElementType val_;
         };
+
+        template
+        <
+            typename ElementType,
+            typename ValueType
+        >
+        struct accumulator<contains_type<ElementType>, ValueType>
+        {
+            using result_type = bool;
+
+            accumulator(const contains_type<ElementType> &op) : val_(op.val_), acc_(false) {}
+
+            void push(const ValueType &val)
+            {
+                acc_ = acc_ || val == val_;
+            }
+
+            result_type result() const
+            {
+                return acc_;
+            }
+
+            ElementType val_;
+            bool acc_;
+        };
     }
 
     template <typename ElementType>
-    detail::contains_type<ElementType> contains(const ElementType &val)
+    constexpr detail::contains_type<ElementType> contains(const ElementType &val)
     {
         return detail::contains_type<ElementType>(val);
     }
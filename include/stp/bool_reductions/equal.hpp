@@ -2,13 +2,25 @@
 #define STP_EQUAL_HPP
 
 #include <algorithm>
+#include <cstddef>
+#include <cstring>
 #include <iterator>
 #include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../traits.hpp"
 
 namespace stp
 {
     namespace detail
     {
+        //Types whose equality is the equality of their object representation
+        template <typename ValueType>
+        struct is_bitwise_comparable : std::integral_constant<bool, std::is_integral<ValueType>::value || std::is_enum<ValueType>::value || std::is_pointer<ValueType>::value> {};
+
+        const std::size_t equal_sample_size = 8;
+
         template
         <
             typename FixedSequenceType,
@@ -16,7 +28,27 @@ namespace stp
         >
         struct equal_type
         {
-            equal_type(const FixedSequenceType &sequence) : fixed_sequence_(sequence) {}
+            //Caches the size of the fixed sequence and a few evenly spaced elements, so that most
+            //mismatching random access sequences are rejected without a full comparison
+            equal_type(const FixedSequenceType &sequence) : fixed_sequence_(sequence), fixed_size_(0)
+            {
+                fixed_size_ = static_cast<std::size_t>(std::distance(std::begin(fixed_sequence_), std::end(fixed_sequence_)));
+
+                if(fixed_size_ >= equal_sample_size)
+                {
+                    auto it = std::begin(fixed_sequence_);
+                    std::size_t pos = 0;
+
+                    for(std::size_t i = 0; i < equal_sample_size; ++i)
+                    {
+                        const std::size_t next = i * (fixed_size_ - 1) / (equal_sample_size - 1);
+                        std::advance(it, next - pos);
+                        pos = next;
+
+                        sample_.push_back(std::make_pair(pos, *it));
+                    }
+                }
+            }
 
             template
             <
@@ -25,6 +57,15 @@ namespace stp
                 typename = typename std::enable_if<std::is_same<ValueType, FixedValueType>::value>::type
             >
             bool operator()(const SequenceType &sequence) const
+            {
+                using IterType = decltype(std::begin(sequence));
+                using CategoryType = typename std::iterator_traits<IterType>::iterator_category;
+
+                return compare(sequence, std::is_base_of<std::random_access_iterator_tag, CategoryType>());
+            }
+
+            template <typename SequenceType>
+            bool compare(const SequenceType &sequence, std::false_type) const
             {
                 auto begin = std::begin(sequence);
                 auto end = std::end(sequence);
@@ -40,7 +81,45 @@ namespace stp
                 return false;
             }
 
+            template <typename SequenceType>
+            bool compare(const SequenceType &sequence, std::true_type) const
+            {
+                using ValueType = typename SequenceType::value_type;
+                using bitwise_type = std::integral_constant<bool, is_contiguous<SequenceType>::value && is_contiguous<FixedSequenceType>::value && is_bitwise_comparable<ValueType>::value>;
+
+                auto begin = std::begin(sequence);
+
+                if(static_cast<std::size_t>(std::distance(begin, std::end(sequence))) != fixed_size_)
+                {
+                    return false;
+                }
+
+                for(const std::pair<std::size_t, FixedValueType> &i : sample_)
+                {
+                    if(!(begin[i.first] == i.second))
+                    {
+                        return false;
+                    }
+                }
+
+                return compare_elements(sequence, bitwise_type());
+            }
+
+            template <typename SequenceType>
+            bool compare_elements(const SequenceType &sequence, std::true_type) const
+            {
+                return fixed_size_ == 0 || std::memcmp(sequence.data(), fixed_sequence_.data(), fixed_size_ * sizeof(FixedValueType)) == 0;
+            }
+
+            template <typename SequenceType>
+            bool compare_elements(const SequenceType &sequence, std::false_type) const
+            {
+                return std::equal(std::begin(sequence), std::end(sequence), std::begin(fixed_sequence_));
+            }
+
             FixedSequenceType fixed_sequence_;
+            std::size_t fixed_size_;
+            std::vector<std::pair<std::size_t, FixedValueType>> sample_;
         };
     }
 
@@ -51,4 +130,4 @@ namespace stp
     }
 }
 
-#endif
\ No newline at end of file
+#endif
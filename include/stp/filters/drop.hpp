@@ -5,19 +5,22 @@
 #include <iterator>
 #include <type_traits>
 
+#include "../traits.hpp"
+
 namespace stp
 {
     namespace detail
     {
         struct drop_type
         {
-            drop_type(const size_t &n) : n_(n) {}
+            constexpr drop_type(const size_t &n) : n_(n) {}
 
             template
             <
                 typename SequenceType,
                 typename IterType = typename SequenceType::iterator,
-                typename DiffType = typename std::iterator_traits<IterType>::difference_type
+                typename DiffType = typename std::iterator_traits<IterType>::difference_type,
+                typename = typename std::enable_if<!is_view<SequenceType>::value>::type
             >
             SequenceType operator()(SequenceType sequence) const
             {
@@ -26,18 +29,36 @@ namespace stp
 
                 DiffType n = static_cast<DiffType>(n_);
 
-                sequence.erase(begin, begin + std::min(n, std::distance(begin, end)));
+                sequence.erase(begin, std::next(begin, std::min(n, std::distance(begin, end))));
 
                 return sequence;
             }
 
+            template
+            <
+                typename SequenceType,
+                typename = typename std::enable_if<is_view<SequenceType>::value>::type
+            >
+            owned_type<SequenceType> operator()(const SequenceType &sequence) const
+            {
+                auto begin = std::begin(sequence);
+                auto end = std::end(sequence);
+
+                for(size_t i = 0; i < n_ && begin != end; ++i)
+                {
+                    ++begin;
+                }
+
+                return owned_type<SequenceType>(begin, end);
+            }
+
             size_t n_;
         };
 
         template <typename Predicate>
         struct drop_while_type
         {
-            drop_while_type(const Predicate &pred) : pred_(pred) {}
+            constexpr drop_while_type(const Predicate &pred) : pred_(pred) {}
 
             template
             <
@@ -46,7 +67,7 @@ namespace stp
                 typename PredType = typename std::result_of<Predicate(ValueType)>::type,
                 typename = typename std::enable_if<std::is_convertible<PredType, bool>::value>::type
             >
-            SequenceType operator()(SequenceType sequence) const
+            owned_type<SequenceType> operator()(const SequenceType &sequence) const
             {
                 size_t n = 0;
                 for(const ValueType &i : sequence)
@@ -69,13 +90,13 @@ namespace stp
         };
     }
 
-    detail::drop_type drop(const size_t &n)
+    constexpr detail::drop_type drop(const size_t &n)
     {
         return detail::drop_type(n);
     }
 
     template <typename Predicate>
-    detail::drop_while_type<Predicate> drop_while(const Predicate &pred)
+    constexpr detail::drop_while_type<Predicate> drop_while(const Predicate &pred)
     {
         return detail::drop_while_type<Predicate>(pred);
     }
@@ -0,0 +1,109 @@
+#ifndef STP_PARALLEL_WHERE_HPP
+#define STP_PARALLEL_WHERE_HPP
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "where.hpp"
+#include "../parallel.hpp"
+#include "../tags.hpp"
+#include "../traits.hpp"
+
+namespace stp
+{
+    namespace detail
+    {
+        const std::size_t parallel_where_grain = 1 << 12;
+
+        //The predicate is evaluated in parallel, and the kept elements are then gathered in order
+        template <typename Predicate>
+        struct par_where_type
+        {
+            constexpr par_where_type(const Predicate &pred) : pred_(pred) {}
+
+            template
+            <
+                typename SequenceType,
+                typename ValueType = typename SequenceType::value_type,
+                typename PredType = typename std::result_of<Predicate(ValueType)>::type,
+                typename = typename std::enable_if<std::is_convertible<PredType, bool>::value>::type,
+                typename = typename std::enable_if<!is_view<SequenceType>::value>::type
+            >
+            SequenceType operator()(SequenceType sequence) const
+            {
+                using IterType = decltype(std::begin(sequence));
+                using CategoryType = typename std::iterator_traits<IterType>::iterator_category;
+
+                return filter(std::move(sequence), std::is_base_of<std::random_access_iterator_tag, CategoryType>());
+            }
+
+            template
+            <
+                typename SequenceType,
+                typename ValueType = typename SequenceType::value_type,
+                typename PredType = typename std::result_of<Predicate(ValueType)>::type,
+                typename = typename std::enable_if<std::is_convertible<PredType, bool>::value>::type,
+                typename = typename std::enable_if<is_view<SequenceType>::value>::type
+            >
+            owned_type<SequenceType> operator()(const SequenceType &sequence) const
+            {
+                return (*this)(materialize(sequence));
+            }
+
+            template <typename SequenceType>
+            SequenceType filter(SequenceType sequence, std::false_type) const
+            {
+                return where_type<Predicate>(pred_)(std::move(sequence));
+            }
+
+            template <typename SequenceType>
+            SequenceType filter(SequenceType sequence, std::true_type) const
+            {
+                auto begin = std::begin(sequence);
+                auto end = std::end(sequence);
+                const std::size_t n = static_cast<std::size_t>(std::distance(begin, end));
+
+                std::vector<unsigned char> keep(n);
+
+                const std::vector<std::size_t> bounds = parallel_chunks(n, parallel_where_grain);
+                parallel_for(bounds.size() - 1, [&](const std::size_t &i)
+                {
+                    for(std::size_t j = bounds[i]; j < bounds[i + 1]; ++j)
+                    {
+                        keep[j] = pred_(begin[j]) ? 1 : 0;
+                    }
+                });
+
+                auto out = begin;
+                for(std::size_t i = 0; i < n; ++i)
+                {
+                    if(keep[i])
+                    {
+                        if(out != begin + i)
+                        {
+                            *out = std::move(begin[i]);
+                        }
+
+                        ++out;
+                    }
+                }
+
+                sequence.erase(out, end);
+                return sequence;
+            }
+
+            Predicate pred_;
+        };
+    }
+
+    template <typename Predicate>
+    constexpr detail::par_where_type<detail::projected_type<Predicate>> where(detail::par_tag, const Predicate &pred)
+    {
+        return detail::par_where_type<detail::projected_type<Predicate>>(pred);
+    }
+}
+
+#endif
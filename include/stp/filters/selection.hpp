@@ -0,0 +1,298 @@
+#ifndef STP_SELECTION_HPP
+#define STP_SELECTION_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../traits.hpp"
+
+namespace stp
+{
+    namespace detail
+    {
+        const std::size_t selection_word_bits = 64;
+
+        inline std::size_t popcount(std::uint64_t word)
+        {
+#if defined(__GNUC__)
+            return static_cast<std::size_t>(__builtin_popcountll(word));
+#else
+            std::size_t count = 0;
+            for(; word != 0; word &= word - 1)
+            {
+                ++count;
+            }
+
+            return count;
+#endif
+        }
+
+        inline std::size_t lowest_bit(const std::uint64_t &word)
+        {
+#if defined(__GNUC__)
+            return static_cast<std::size_t>(__builtin_ctzll(word));
+#else
+            std::size_t bit = 0;
+            while(((word >> bit) & 1) == 0)
+            {
+                ++bit;
+            }
+
+            return bit;
+#endif
+        }
+
+        inline std::size_t highest_bit(const std::uint64_t &word)
+        {
+#if defined(__GNUC__)
+            return selection_word_bits - 1 - static_cast<std::size_t>(__builtin_clzll(word));
+#else
+            std::size_t bit = selection_word_bits - 1;
+            while(((word >> bit) & 1) == 0)
+            {
+                --bit;
+            }
+
+            return bit;
+#endif
+        }
+
+        //The position of the first set bit at or after pos, or n if there is none
+        inline std::size_t next_selected(const std::vector<std::uint64_t> &bits, const std::size_t &pos, const std::size_t &n)
+        {
+            std::size_t word = pos / selection_word_bits;
+            if(word >= bits.size())
+            {
+                return n;
+            }
+
+            std::uint64_t current = bits[word] & (~std::uint64_t(0) << (pos % selection_word_bits));
+            while(current == 0)
+            {
+                if(++word == bits.size())
+                {
+                    return n;
+                }
+
+                current = bits[word];
+            }
+
+            return word * selection_word_bits + lowest_bit(current);
+        }
+
+        //The position of the last set bit before pos, which must exist
+        inline std::size_t prev_selected(const std::vector<std::uint64_t> &bits, const std::size_t &pos)
+        {
+            std::size_t word = (pos - 1) / selection_word_bits;
+            std::uint64_t current = bits[word] & (~std::uint64_t(0) >> (selection_word_bits - 1 - (pos - 1) % selection_word_bits));
+            while(current == 0)
+            {
+                current = bits[--word];
+            }
+
+            return word * selection_word_bits + highest_bit(current);
+        }
+
+        template <typename SequenceType>
+        struct is_random_access : std::is_base_of<std::random_access_iterator_tag, typename std::iterator_traits<decltype(std::begin(std::declval<const typename std::decay<SequenceType>::type &>()))>::iterator_category> {};
+
+        //The elements of an lvalue random access sequence, or of an rvalue one it takes ownership of, which
+        //are marked in a bitmap. Chained filters clear bits instead of moving elements, and the selected
+        //elements are only gathered when the view is traversed or converted.
+        template <typename SequenceType>
+        class selection_view : public view_base
+        {
+            private:
+                using container_type = typename std::decay<SequenceType>::type;
+                using base_iterator = typename container_type::const_iterator;
+
+            public:
+                using value_type = typename container_type::value_type;
+                using difference_type = std::ptrdiff_t;
+                using size_type = std::size_t;
+
+                class const_iterator
+                {
+                    public:
+                        using iterator_category = std::bidirectional_iterator_tag;
+                        using value_type = typename container_type::value_type;
+                        using difference_type = std::ptrdiff_t;
+                        using pointer = typename std::iterator_traits<base_iterator>::pointer;
+                        using reference = typename std::iterator_traits<base_iterator>::reference;
+
+                        const_iterator() : bits_(nullptr), pos_(0), n_(0) {}
+
+                        const_iterator(base_iterator base, const std::vector<std::uint64_t> *bits, const std::size_t &pos, const std::size_t &n)
+                            : base_(base), bits_(bits), pos_(pos), n_(n) {}
+
+                        reference operator*() const
+                        {
+                            return base_[static_cast<difference_type>(pos_)];
+                        }
+
+                        pointer operator->() const
+                        {
+                            return &base_[static_cast<difference_type>(pos_)];
+                        }
+
+                        const_iterator &operator++()
+                        {
+                            pos_ = next_selected(*bits_, pos_ + 1, n_);
+                            return *this;
+                        }
+
+                        const_iterator operator++(int)
+                        {
+                            const_iterator it(*this);
+                            ++(*this);
+                            return it;
+                        }
+
+                        const_iterator &operator--()
+                        {
+                            pos_ = prev_selected(*bits_, pos_);
+                            return *this;
+                        }
+
+                        const_iterator operator--(int)
+                        {
+                            const_iterator it(*this);
+                            --(*this);
+                            return it;
+                        }
+
+                        bool operator==(const const_iterator &other) const
+                        {
+                            return pos_ == other.pos_;
+                        }
+
+                        bool operator!=(const const_iterator &other) const
+                        {
+                            return pos_ != other.pos_;
+                        }
+
+                    private:
+                        base_iterator base_;
+                        const std::vector<std::uint64_t> *bits_;
+                        std::size_t pos_;
+                        std::size_t n_;
+                };
+
+                using iterator = const_iterator;
+
+                template <typename Predicate>
+                selection_view(SequenceType &&sequence, const Predicate &pred) : sequence_(std::forward<SequenceType>(sequence)), count_(0)
+                {
+                    auto base = std::begin(container());
+                    n_ = static_cast<std::size_t>(std::distance(base, std::end(container())));
+                    bits_.assign((n_ + selection_word_bits - 1) / selection_word_bits, 0);
+
+                    for(std::size_t word = 0; word < bits_.size(); ++word)
+                    {
+                        const std::size_t first = word * selection_word_bits;
+                        const std::size_t last = first + selection_word_bits < n_ ? first + selection_word_bits : n_;
+
+                        std::uint64_t current = 0;
+                        for(std::size_t i = first; i < last; ++i)
+                        {
+                            current |= static_cast<std::uint64_t>(pred(base[static_cast<difference_type>(i)]) ? 1 : 0) << (i - first);
+                        }
+
+                        bits_[word] = current;
+                        count_ += popcount(current);
+                    }
+                }
+
+                //Clears the bits of the selected elements which fail pred, without testing the others
+                template <typename Predicate>
+                void refine(const Predicate &pred)
+                {
+                    auto base = std::begin(container());
+
+                    count_ = 0;
+                    for(std::size_t word = 0; word < bits_.size(); ++word)
+                    {
+                        std::uint64_t current = bits_[word];
+                        for(std::uint64_t rest = current; rest != 0; rest &= rest - 1)
+                        {
+                            const std::size_t bit = lowest_bit(rest);
+                            if(!pred(base[static_cast<difference_type>(word * selection_word_bits + bit)]))
+                            {
+                                current &= ~(std::uint64_t(1) << bit);
+                            }
+                        }
+
+                        bits_[word] = current;
+                        count_ += popcount(current);
+                    }
+                }
+
+                const_iterator begin() const
+                {
+                    return const_iterator(std::begin(container()), &bits_, next_selected(bits_, 0, n_), n_);
+                }
+
+                const_iterator end() const
+                {
+                    return const_iterator(std::begin(container()), &bits_, n_, n_);
+                }
+
+                //Counted from the bitmap, without visiting any element
+                size_type size() const
+                {
+                    return count_;
+                }
+
+                bool empty() const
+                {
+                    return count_ == 0;
+                }
+
+                const std::vector<std::uint64_t> &bitmap() const
+                {
+                    return bits_;
+                }
+
+                operator container_type() const
+                {
+                    return container_type(begin(), end());
+                }
+
+            private:
+                const container_type &container() const
+                {
+                    return sequence_;
+                }
+
+                SequenceType sequence_;
+                std::vector<std::uint64_t> bits_;
+                std::size_t n_;
+                std::size_t count_;
+        };
+
+        template <typename SequenceType>
+        struct is_selection : std::false_type {};
+
+        template <typename SequenceType>
+        struct is_selection<selection_view<SequenceType>> : std::true_type {};
+
+        template <typename SequenceType>
+        struct tail<selection_view<SequenceType>>
+        {
+            using type = typename std::decay<SequenceType>::type;
+        };
+
+        //Operations on a selection build the type of the selected sequence, as they would without the view
+        template <typename SequenceType>
+        struct owned<selection_view<SequenceType>, true>
+        {
+            using type = typename std::decay<SequenceType>::type;
+        };
+    }
+}
+
+#endif
@@ -5,19 +5,22 @@
 #include <iterator>
 #include <type_traits>
 
+#include "../traits.hpp"
+
 namespace stp
 {
     namespace detail
     {
         struct take_type
         {
-            take_type(const size_t &n) : n_(n) {}
+            constexpr take_type(const size_t &n) : n_(n) {}
 
             template
             <
                 typename SequenceType,
                 typename IterType = typename SequenceType::iterator,
-                typename DiffType = typename std::iterator_traits<IterType>::difference_type
+                typename DiffType = typename std::iterator_traits<IterType>::difference_type,
+                typename = typename std::enable_if<!is_view<SequenceType>::value>::type
             >
             SequenceType operator()(SequenceType sequence) const
             {
@@ -26,18 +29,38 @@ namespace stp
 
                 DiffType n = static_cast<DiffType>(n_);
 
-                sequence.erase(begin + std::min(n, std::distance(begin, end)), end);
+                sequence.erase(std::next(begin, std::min(n, std::distance(begin, end))), end);
 
                 return sequence;
             }
 
+            template
+            <
+                typename SequenceType,
+                typename = typename std::enable_if<is_view<SequenceType>::value>::type
+            >
+            owned_type<SequenceType> operator()(const SequenceType &sequence) const
+            {
+                owned_type<SequenceType> result;
+
+                auto begin = std::begin(sequence);
+                auto end = std::end(sequence);
+
+                for(size_t i = 0; i < n_ && begin != end; ++i, ++begin)
+                {
+                    result.push_back(*begin);
+                }
+
+                return result;
+            }
+
             size_t n_;
         };
 
         template <typename Predicate>
         struct take_while_type
         {
-            take_while_type(const Predicate &pred) : pred_(pred) {}
+            constexpr take_while_type(const Predicate &pred) : pred_(pred) {}
 
             template
             <
@@ -46,7 +69,7 @@ namespace stp
                 typename PredType = typename std::result_of<Predicate(ValueType)>::type,
                 typename = typename std::enable_if<std::is_convertible<PredType, bool>::value>::type
             >
-            SequenceType operator()(SequenceType sequence) const
+            owned_type<SequenceType> operator()(const SequenceType &sequence) const
             {
                 size_t n = 0;
                 for(const ValueType &i : sequence)
@@ -69,13 +92,13 @@ namespace stp
         };
     }
 
-    detail::take_type take(const size_t &n)
+    constexpr detail::take_type take(const size_t &n)
     {
         return detail::take_type(n);
     }
 
     template <typename Predicate>
-    detail::take_while_type<Predicate> take_while(const Predicate &pred)
+    constexpr detail::take_while_type<Predicate> take_while(const Predicate &pred)
     {
         return detail::take_while_type<Predicate>(pred);
     }
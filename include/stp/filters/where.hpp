@@ -4,6 +4,12 @@
 #include <algorithm>
 #include <iterator>
 #include <type_traits>
+#include <utility>
+
+#include "../accumulator.hpp"
+#include "../misc/bind.hpp"
+#include "selection.hpp"
+#include "../traits.hpp"
 
 namespace stp
 {
@@ -12,14 +18,30 @@ namespace stp
         template <typename Predicate>
         struct where_type
         {
-            where_type(const Predicate &pred) : pred_(pred) {}
+            constexpr where_type(const Predicate &pred) : pred_(pred) {}
+
+            //Random access sequences are not modified, but marked in a bitmap which further filters refine
+            template
+            <
+                typename SequenceType,
+                typename ValueType = typename std::decay<SequenceType>::type::value_type,
+                typename PredType = typename std::result_of<Predicate(ValueType)>::type,
+                typename = typename std::enable_if<std::is_convertible<PredType, bool>::value>::type,
+                typename = typename std::enable_if<!is_view<SequenceType>::value && is_random_access<SequenceType>::value>::type
+            >
+            selection_view<SequenceType> operator()(SequenceType &&sequence) const
+            {
+                return selection_view<SequenceType>(std::forward<SequenceType>(sequence), pred_);
+            }
 
             template
             <
                 typename SequenceType,
                 typename ValueType = typename SequenceType::value_type,
                 typename PredType = typename std::result_of<Predicate(ValueType)>::type,
-                typename = typename std::enable_if<std::is_convertible<PredType, bool>::value>::type
+                typename = typename std::enable_if<std::is_convertible<PredType, bool>::value>::type,
+                typename = typename std::enable_if<!is_view<SequenceType>::value && !is_random_access<SequenceType>::value>::type,
+                typename = void
             >
             SequenceType operator()(SequenceType sequence) const
             {
@@ -32,14 +54,96 @@ namespace stp
                 return sequence;
             }
 
+            template
+            <
+                typename SequenceType,
+                typename ValueType = typename selection_view<SequenceType>::value_type,
+                typename PredType = typename std::result_of<Predicate(ValueType)>::type,
+                typename = typename std::enable_if<std::is_convertible<PredType, bool>::value>::type
+            >
+            selection_view<SequenceType> operator()(selection_view<SequenceType> selection) const
+            {
+                selection.refine(pred_);
+                return selection;
+            }
+
+            template
+            <
+                typename SequenceType,
+                typename ValueType = typename SequenceType::value_type,
+                typename PredType = typename std::result_of<Predicate(ValueType)>::type,
+                typename = typename std::enable_if<std::is_convertible<PredType, bool>::value>::type,
+                typename = typename std::enable_if<is_view<SequenceType>::value && !is_selection<SequenceType>::value>::type
+            >
+            owned_type<SequenceType> operator()(const SequenceType &sequence) const
+            {
+                owned_type<SequenceType> result;
+                for(const ValueType &i : sequence)
+                {
+                    if(pred_(i))
+                    {
+                        result.push_back(i);
+                    }
+                }
+
+                return result;
+            }
+
             Predicate pred_;
         };
+
+        //Evaluates the bound transformation once, rather than once per element
+        template
+        <
+            typename InnerType,
+            typename Function
+        >
+        struct where_type<bound_type<InnerType, Function>>
+        {
+            template <typename SequenceType>
+            using call_type = typename bound_type<InnerType, Function>::template call_type<typename std::decay<SequenceType>::type>;
+
+            constexpr where_type(const bound_type<InnerType, Function> &pred) : pred_(pred) {}
+
+            template
+            <
+                typename SequenceType,
+                typename ResultType = typename std::result_of<where_type<call_type<SequenceType>>(SequenceType)>::type
+            >
+            ResultType operator()(SequenceType &&sequence) const
+            {
+                where_type<call_type<SequenceType>> op(pred_.bind(sequence));
+                return op(std::forward<SequenceType>(sequence));
+            }
+
+            bound_type<InnerType, Function> pred_;
+        };
+
+        template <typename Predicate>
+        struct element_op<where_type<Predicate>>
+        {
+            template <typename ValueType>
+            using output_type = ValueType;
+
+            template
+            <
+                typename ValueType,
+                typename NextType
+            >
+            static void apply(const where_type<Predicate> &op, const ValueType &val, NextType &next)
+            {
+                if(op.pred_(val))
+                {
+                    next(val);
+                }
+            }
+        };
     }
 
     template <typename Predicate>
-    detail::where_type<Predicate> where(const Predicate &pred)
+    constexpr detail::where_type<detail::projected_type<Predicate>> where(const Predicate &pred)
     {
-        return detail::where_type<Predicate>(pred);
+        return detail::where_type<detail::projected_type<Predicate>>(pred);
     }
 }
 
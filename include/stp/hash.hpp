@@ -0,0 +1,31 @@
+#ifndef STP_HASH_HPP
+#define STP_HASH_HPP
+
+#include <cstdint>
+#include <functional>
+
+namespace stp
+{
+    namespace detail
+    {
+        //std::hash is the identity for integers on common implementations, so
+        //the bits are mixed before they are used for bucketing or estimation
+        inline std::uint64_t mix_hash(std::uint64_t h)
+        {
+            h ^= h >> 33;
+            h *= 0xff51afd7ed558ccdULL;
+            h ^= h >> 33;
+            h *= 0xc4ceb9fe1a85ec53ULL;
+            h ^= h >> 33;
+            return h;
+        }
+
+        template <typename ValueType>
+        std::uint64_t hash_value(const ValueType &val)
+        {
+            return mix_hash(static_cast<std::uint64_t>(std::hash<ValueType>()(val)));
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,155 @@
+#ifndef STP_INCREMENTAL_HPP
+#define STP_INCREMENTAL_HPP
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+
+#include "accumulator.hpp"
+
+namespace stp
+{
+    namespace detail
+    {
+        //The type of the elements which reach the final operation
+        template
+        <
+            typename ValueType,
+            typename ...OpTypes
+        >
+        struct chain_output;
+
+        template
+        <
+            typename ValueType,
+            typename TerminalType
+        >
+        struct chain_output<ValueType, TerminalType>
+        {
+            using type = ValueType;
+        };
+
+        template
+        <
+            typename ValueType,
+            typename OpType,
+            typename ...Rest
+        >
+        struct chain_output<ValueType, OpType, Rest...> : chain_output<typename element_op<OpType>::template output_type<ValueType>, Rest...> {};
+
+        //Evaluates element-wise operations followed by a reduction over a sequence which is only ever appended to.
+        //The elements processed so far are remembered along with the state of the reduction, so evaluating the
+        //same sequence again only processes the elements appended since. A different sequence, or one which has
+        //become shorter, is evaluated from the start.
+        template
+        <
+            typename SequenceType,
+            typename ...OpTypes
+        >
+        class incremental_type
+        {
+            private:
+                using op_tuple = std::tuple<OpTypes...>;
+
+                static const std::size_t terminal = sizeof...(OpTypes) - 1;
+
+                using terminal_type = typename std::tuple_element<terminal, op_tuple>::type;
+                using input_type = typename SequenceType::value_type;
+                using accumulator_type = accumulator<terminal_type, typename chain_output<input_type, OpTypes...>::type>;
+
+                template <std::size_t I>
+                struct stage
+                {
+                    template <typename ValueType>
+                    void operator()(const ValueType &val)
+                    {
+                        self_->template feed<I>(val, std::integral_constant<bool, I == terminal>());
+                    }
+
+                    incremental_type *self_;
+                };
+
+            public:
+                using result_type = typename accumulator_type::result_type;
+
+                incremental_type(OpTypes... ops) : ops_(ops...), acc_(new accumulator_type(std::get<terminal>(ops_))), source_(nullptr), processed_(0) {}
+
+                result_type operator()(const SequenceType &sequence)
+                {
+                    const std::size_t size = static_cast<std::size_t>(std::distance(std::begin(sequence), std::end(sequence)));
+
+                    if(&sequence != source_ || size < processed_)
+                    {
+                        reset();
+                        source_ = &sequence;
+                    }
+
+                    auto it = std::begin(sequence);
+                    std::advance(it, processed_);
+
+                    stage<0> first = {this};
+                    for(auto end = std::end(sequence); it != end; ++it)
+                    {
+                        first(*it);
+                    }
+
+                    processed_ = size;
+                    return acc_->result();
+                }
+
+                //Forgets all processed elements, for when elements have been modified rather than appended
+                void reset()
+                {
+                    acc_.reset(new accumulator_type(std::get<terminal>(ops_)));
+                    source_ = nullptr;
+                    processed_ = 0;
+                }
+
+                std::size_t processed() const
+                {
+                    return processed_;
+                }
+
+            private:
+                template
+                <
+                    std::size_t I,
+                    typename ValueType
+                >
+                void feed(const ValueType &val, std::false_type)
+                {
+                    stage<I + 1> next = {this};
+                    element_op<typename std::tuple_element<I, op_tuple>::type>::apply(std::get<I>(ops_), val, next);
+                }
+
+                template
+                <
+                    std::size_t I,
+                    typename ValueType
+                >
+                void feed(const ValueType &val, std::true_type)
+                {
+                    acc_->push(val);
+                }
+
+                op_tuple ops_;
+                std::unique_ptr<accumulator_type> acc_;
+                const SequenceType *source_;
+                std::size_t processed_;
+        };
+    }
+
+    template
+    <
+        typename SequenceType,
+        typename ...OpTypes
+    >
+    detail::incremental_type<SequenceType, OpTypes...> make_incremental(OpTypes... ops)
+    {
+        return detail::incremental_type<SequenceType, OpTypes...>(ops...);
+    }
+}
+
+#endif
@@ -0,0 +1,205 @@
+#ifndef STP_MEMOIZE_HPP
+#define STP_MEMOIZE_HPP
+
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+#include "traits.hpp"
+
+namespace stp
+{
+    namespace detail
+    {
+        //Identifies a cached result either by the address of the sequence and a version
+        //stamp, or by a hash of its elements, in which case source is null
+        struct memo_key
+        {
+            bool operator==(const memo_key &other) const
+            {
+                return source_ == other.source_ && stamp_ == other.stamp_;
+            }
+
+            const void *source_;
+            std::size_t stamp_;
+        };
+
+        struct memo_key_hash
+        {
+            std::size_t operator()(const memo_key &key) const
+            {
+                return std::hash<const void *>()(key.source_) ^ (std::hash<std::size_t>()(key.stamp_) + 0x9e3779b9u);
+            }
+        };
+
+        template <typename SequenceType>
+        std::size_t content_hash(const SequenceType &sequence)
+        {
+            using ValueType = typename SequenceType::value_type;
+
+            std::size_t seed = 0;
+            for(const ValueType &i : sequence)
+            {
+                seed ^= std::hash<ValueType>()(i) + 0x9e3779b9u + (seed << 6) + (seed >> 2);
+            }
+
+            return seed;
+        }
+
+        //A bounded cache of pipeline results, evicting the least recently used result when full.
+        //Results keyed by content keep a copy of the sequence, so hash collisions are never returned.
+        template
+        <
+            typename SequenceType,
+            typename ResultType
+        >
+        class memo_cache
+        {
+            private:
+                struct entry
+                {
+                    memo_key key_;
+                    ResultType result_;
+                    std::unique_ptr<SequenceType> content_;
+                };
+
+                using entry_list = std::list<entry>;
+
+            public:
+                memo_cache(const std::size_t &capacity) : capacity_(capacity) {}
+
+                bool find(const memo_key &key, const SequenceType *content, ResultType &result)
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+
+                    auto it = index_.find(key);
+                    if(it == index_.end() || (content && !(*it->second->content_ == *content)))
+                    {
+                        return false;
+                    }
+
+                    entries_.splice(entries_.begin(), entries_, it->second);
+                    result = it->second->result_;
+                    return true;
+                }
+
+                void insert(const memo_key &key, const SequenceType *content, const ResultType &result)
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+
+                    auto it = index_.find(key);
+                    if(it != index_.end())
+                    {
+                        entries_.erase(it->second);
+                        index_.erase(it);
+                    }
+                    else if(entries_.size() == capacity_)
+                    {
+                        index_.erase(entries_.back().key_);
+                        entries_.pop_back();
+                    }
+
+                    entries_.push_front(entry{key, result, std::unique_ptr<SequenceType>(content ? new SequenceType(*content) : nullptr)});
+                    index_.insert(std::make_pair(key, entries_.begin()));
+                }
+
+                void clear()
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+
+                    index_.clear();
+                    entries_.clear();
+                }
+
+                std::size_t size()
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    return entries_.size();
+                }
+
+            private:
+                std::size_t capacity_;
+                std::mutex mutex_;
+                entry_list entries_;
+                std::unordered_map<memo_key, typename entry_list::iterator, memo_key_hash> index_;
+        };
+
+        //Copies share the cache, so a memoized pipeline can be captured by value
+        template
+        <
+            typename SequenceType,
+            typename PipelineType
+        >
+        class memoize_type
+        {
+            public:
+                using result_type = typename std::decay<typename std::result_of<const PipelineType(const SequenceType &)>::type>::type;
+
+                static_assert(!is_view<result_type>::value, "A memoized pipeline must not return a view of its input");
+
+                memoize_type(const PipelineType &pipeline, const std::size_t &capacity)
+                    : pipeline_(pipeline), cache_(std::make_shared<memo_cache<SequenceType, result_type>>(capacity)) {}
+
+                //Keyed by the address of the sequence and a version, which the caller must change whenever the sequence is modified
+                result_type operator()(const SequenceType &sequence, const std::size_t &version) const
+                {
+                    return evaluate(sequence, memo_key{&sequence, version}, nullptr);
+                }
+
+                //Keyed by the elements of the sequence, which are hashed and compared on every call
+                result_type operator()(const SequenceType &sequence) const
+                {
+                    return evaluate(sequence, memo_key{nullptr, content_hash(sequence)}, &sequence);
+                }
+
+                void clear() const
+                {
+                    cache_->clear();
+                }
+
+                std::size_t size() const
+                {
+                    return cache_->size();
+                }
+
+            private:
+                result_type evaluate(const SequenceType &sequence, const memo_key &key, const SequenceType *content) const
+                {
+                    result_type result;
+                    if(!cache_->find(key, content, result))
+                    {
+                        result = pipeline_(sequence);
+                        cache_->insert(key, content, result);
+                    }
+
+                    return result;
+                }
+
+                PipelineType pipeline_;
+                std::shared_ptr<memo_cache<SequenceType, result_type>> cache_;
+        };
+    }
+
+    template
+    <
+        typename SequenceType,
+        typename PipelineType
+    >
+    detail::memoize_type<SequenceType, PipelineType> memoize(const PipelineType &pipeline, const std::size_t &capacity = 16)
+    {
+        if(capacity == 0)
+        {
+            throw std::invalid_argument("Cache capacity must be positive");
+        }
+
+        return detail::memoize_type<SequenceType, PipelineType>(pipeline, capacity);
+    }
+}
+
+#endif
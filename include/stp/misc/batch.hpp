@@ -0,0 +1,229 @@
+#ifndef STP_BATCH_HPP
+#define STP_BATCH_HPP
+
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../traits.hpp"
+
+namespace stp
+{
+    namespace detail
+    {
+        template <typename IterType>
+        IterType advance_bounded(IterType first, const std::size_t &n, const IterType &last, std::random_access_iterator_tag)
+        {
+            const std::size_t remaining = static_cast<std::size_t>(last - first);
+            return first + static_cast<typename std::iterator_traits<IterType>::difference_type>(n < remaining ? n : remaining);
+        }
+
+        template <typename IterType>
+        IterType advance_bounded(IterType first, const std::size_t &n, const IterType &last, std::input_iterator_tag)
+        {
+            for(std::size_t i = 0; i < n && first != last; ++i)
+            {
+                ++first;
+            }
+
+            return first;
+        }
+
+        //A contiguous part of another sequence, which it refers to without copying
+        template <typename IterType>
+        class chunk : public view_base
+        {
+            public:
+                using value_type = typename std::iterator_traits<IterType>::value_type;
+                using const_iterator = IterType;
+                using iterator = IterType;
+                using difference_type = typename std::iterator_traits<IterType>::difference_type;
+                using size_type = std::size_t;
+
+                chunk(IterType first, IterType last) : first_(first), last_(last) {}
+
+                const_iterator begin() const
+                {
+                    return first_;
+                }
+
+                const_iterator end() const
+                {
+                    return last_;
+                }
+
+                size_type size() const
+                {
+                    return static_cast<size_type>(std::distance(first_, last_));
+                }
+
+                bool empty() const
+                {
+                    return first_ == last_;
+                }
+
+                operator std::vector<value_type>() const
+                {
+                    return std::vector<value_type>(first_, last_);
+                }
+
+            private:
+                IterType first_;
+                IterType last_;
+        };
+
+        //Splits an lvalue sequence, or an rvalue sequence it takes ownership of, into chunks of n elements.
+        //Only the last chunk may be shorter. Chunks are formed as the view is traversed.
+        template <typename SequenceType>
+        class batch_view : public view_base
+        {
+            private:
+                using container_type = typename std::decay<SequenceType>::type;
+                using inner_iterator = typename container_type::const_iterator;
+                using category_type = typename std::iterator_traits<inner_iterator>::iterator_category;
+
+            public:
+                using value_type = chunk<inner_iterator>;
+                using difference_type = std::ptrdiff_t;
+                using size_type = std::size_t;
+
+                class const_iterator
+                {
+                    public:
+                        using iterator_category = std::input_iterator_tag;
+                        using value_type = chunk<inner_iterator>;
+                        using difference_type = std::ptrdiff_t;
+                        using pointer = const value_type *;
+                        using reference = value_type;
+
+                        const_iterator(inner_iterator first, inner_iterator end, const std::size_t &n)
+                            : first_(first), last_(advance_bounded(first, n, end, category_type())), end_(end), n_(n) {}
+
+                        value_type operator*() const
+                        {
+                            return value_type(first_, last_);
+                        }
+
+                        const_iterator &operator++()
+                        {
+                            first_ = last_;
+                            last_ = advance_bounded(first_, n_, end_, category_type());
+                            return *this;
+                        }
+
+                        const_iterator operator++(int)
+                        {
+                            const_iterator it(*this);
+                            ++(*this);
+                            return it;
+                        }
+
+                        bool operator==(const const_iterator &other) const
+                        {
+                            return first_ == other.first_;
+                        }
+
+                        bool operator!=(const const_iterator &other) const
+                        {
+                            return first_ != other.first_;
+                        }
+
+                    private:
+                        inner_iterator first_;
+                        inner_iterator last_;
+                        inner_iterator end_;
+                        std::size_t n_;
+                };
+
+                using iterator = const_iterator;
+
+                batch_view(SequenceType &&sequence, const std::size_t &n) : sequence_(std::forward<SequenceType>(sequence)), n_(n) {}
+
+                const_iterator begin() const
+                {
+                    return const_iterator(std::begin(container()), std::end(container()), n_);
+                }
+
+                const_iterator end() const
+                {
+                    return const_iterator(std::end(container()), std::end(container()), n_);
+                }
+
+                size_type size() const
+                {
+                    const std::size_t elements = static_cast<std::size_t>(std::distance(std::begin(container()), std::end(container())));
+                    return (elements + n_ - 1) / n_;
+                }
+
+                bool empty() const
+                {
+                    return std::begin(container()) == std::end(container());
+                }
+
+            private:
+                const container_type &container() const
+                {
+                    return sequence_;
+                }
+
+                SequenceType sequence_;
+                std::size_t n_;
+        };
+
+        //Chunks refer to the batched sequence, so an owned copy of a batch holds copies of the elements
+        template <typename SequenceType>
+        struct owned<batch_view<SequenceType>, true>
+        {
+            using type = std::vector<std::vector<typename std::decay<SequenceType>::type::value_type>>;
+        };
+
+        struct batch_type
+        {
+            batch_type(const std::size_t &n) : n_(n) {}
+
+            template
+            <
+                typename SequenceType,
+                typename = typename std::enable_if<!is_transient<typename std::decay<SequenceType>::type>::value>::type
+            >
+            batch_view<SequenceType> operator()(SequenceType &&sequence) const
+            {
+                return batch_view<SequenceType>(std::forward<SequenceType>(sequence), n_);
+            }
+
+            //Gathered first, so that batches have the type of batches of the sequence the view stands in for
+            template
+            <
+                typename SequenceType,
+                typename ContainerType = tail_type<typename std::decay<SequenceType>::type>,
+                typename = typename std::enable_if<is_transient<typename std::decay<SequenceType>::type>::value>::type,
+                typename = void
+            >
+            batch_view<ContainerType> operator()(const SequenceType &sequence) const
+            {
+                return batch_view<ContainerType>(ContainerType(sequence), n_);
+            }
+
+            std::size_t n_;
+        };
+    }
+
+    //The type of a single batch of SequenceType, for declaring the parameters of operations on batches
+    template <typename SequenceType>
+    using batch_of = detail::chunk<typename SequenceType::const_iterator>;
+
+    inline detail::batch_type batch(const std::size_t &n)
+    {
+        if(n == 0)
+        {
+            throw std::invalid_argument("Batch size must be positive");
+        }
+
+        return detail::batch_type(n);
+    }
+}
+
+#endif
@@ -0,0 +1,73 @@
+#ifndef STP_BIND_HPP
+#define STP_BIND_HPP
+
+#include <type_traits>
+#include <utility>
+
+#include "../traits.hpp"
+
+namespace stp
+{
+    namespace detail
+    {
+        //Calls the bound function with a value computed beforehand and a single element
+        template
+        <
+            typename BoundType,
+            typename Function
+        >
+        struct bound_call
+        {
+            constexpr bound_call(const BoundType &val, const Function &fn) : val_(val), fn_(fn) {}
+
+            template <typename ElementType>
+            auto operator()(const ElementType &element) const -> decltype(std::declval<const Function &>()(std::declval<const BoundType &>(), element))
+            {
+                return fn_(val_, element);
+            }
+
+            BoundType val_;
+            Function fn_;
+        };
+
+        //Used in place of a predicate or operation of where and map, which evaluate the inner
+        //transformation once over their whole input and pass the result along with each element
+        template
+        <
+            typename InnerType,
+            typename Function
+        >
+        struct bound_type
+        {
+            template <typename SequenceType>
+            using inner_result = typename std::decay<typename std::result_of<const InnerType(const SequenceType &)>::type>::type;
+
+            template <typename SequenceType>
+            using call_type = bound_call<inner_result<SequenceType>, Function>;
+
+            constexpr bound_type(const InnerType &inner, const Function &fn) : inner_(inner), fn_(fn) {}
+
+            template <typename SequenceType>
+            call_type<SequenceType> bind(const SequenceType &sequence) const
+            {
+                static_assert(!is_view<inner_result<SequenceType>>::value, "A bound transformation must not return a view of its input");
+                return call_type<SequenceType>(inner_(sequence), fn_);
+            }
+
+            InnerType inner_;
+            Function fn_;
+        };
+    }
+
+    template
+    <
+        typename InnerType,
+        typename Function
+    >
+    constexpr detail::bound_type<InnerType, Function> bind(const InnerType &inner, const Function &fn)
+    {
+        return detail::bound_type<InnerType, Function>(inner, fn);
+    }
+}
+
+#endif
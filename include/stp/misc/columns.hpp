@@ -0,0 +1,436 @@
+#ifndef STP_COLUMNS_HPP
+#define STP_COLUMNS_HPP
+
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../accumulator.hpp"
+#include "../traits.hpp"
+
+namespace stp
+{
+    //Stores records as one std::vector per field, so an operation on a single field reads only that field
+    template <typename ...ValueTypes>
+    class columns
+    {
+        static_assert(sizeof...(ValueTypes) > 0, "A columnar sequence must have at least one column");
+
+        private:
+            using index_type = typename detail::make_index_sequence<sizeof...(ValueTypes)>::type;
+
+        public:
+            template <std::size_t I>
+            using element_type = typename std::tuple_element<I, std::tuple<ValueTypes...>>::type;
+
+            using size_type = std::size_t;
+
+            columns() {}
+
+            columns(std::vector<ValueTypes>... cols) : columns_(std::move(cols)...)
+            {
+                if(!same_size(index_type()))
+                {
+                    throw std::invalid_argument("Columns must have the same size");
+                }
+            }
+
+            void push_back(const ValueTypes &...vals)
+            {
+                push_back(index_type(), vals...);
+            }
+
+            void reserve(const size_type &n)
+            {
+                reserve(index_type(), n);
+            }
+
+            template <std::size_t I>
+            const std::vector<element_type<I>> &column() const
+            {
+                return std::get<I>(columns_);
+            }
+
+            size_type size() const
+            {
+                return std::get<0>(columns_).size();
+            }
+
+            bool empty() const
+            {
+                return std::get<0>(columns_).empty();
+            }
+
+        private:
+            template <std::size_t ...I>
+            bool same_size(detail::index_sequence<I...>) const
+            {
+                const size_type sizes[] = {std::get<I>(columns_).size()...};
+                for(const size_type &i : sizes)
+                {
+                    if(i != sizes[0])
+                    {
+                        return false;
+                    }
+                }
+
+                return true;
+            }
+
+            template <std::size_t ...I>
+            void push_back(detail::index_sequence<I...>, const ValueTypes &...vals)
+            {
+                int expand[] = {(std::get<I>(columns_).push_back(vals), 0)...};
+                (void)expand;
+            }
+
+            template <std::size_t ...I>
+            void reserve(detail::index_sequence<I...>, const size_type &n)
+            {
+                int expand[] = {(std::get<I>(columns_).reserve(n), 0)...};
+                (void)expand;
+            }
+
+            std::tuple<std::vector<ValueTypes>...> columns_;
+    };
+
+    namespace detail
+    {
+        template <typename SequenceType>
+        struct is_columns : std::false_type {};
+
+        template <typename ...ValueTypes>
+        struct is_columns<columns<ValueTypes...>> : std::true_type {};
+
+        //The rows of an lvalue columnar sequence, or of an rvalue one it takes ownership of, which have passed
+        //every where_column so far. Only the columns which were tested have been read.
+        template <typename ColumnsType>
+        class column_selection
+        {
+            private:
+                using container_type = typename std::decay<ColumnsType>::type;
+
+            public:
+                using size_type = std::size_t;
+
+                column_selection(ColumnsType &&cols, std::vector<std::size_t> &&rows) : columns_(std::forward<ColumnsType>(cols)), rows_(std::move(rows)) {}
+
+                const container_type &source() const
+                {
+                    return columns_;
+                }
+
+                const std::vector<std::size_t> &rows() const
+                {
+                    return rows_;
+                }
+
+                std::vector<std::size_t> &rows()
+                {
+                    return rows_;
+                }
+
+                size_type size() const
+                {
+                    return rows_.size();
+                }
+
+                bool empty() const
+                {
+                    return rows_.empty();
+                }
+
+            private:
+                ColumnsType columns_;
+                std::vector<std::size_t> rows_;
+        };
+
+        template <typename SequenceType>
+        struct is_column_selection : std::false_type {};
+
+        template <typename ColumnsType>
+        struct is_column_selection<column_selection<ColumnsType>> : std::true_type {};
+
+        //A single column of a columnar sequence, referred to without copying
+        template
+        <
+            typename ColumnsType,
+            std::size_t I
+        >
+        class column_view : public view_base
+        {
+            private:
+                using container_type = typename std::decay<ColumnsType>::type;
+                using column_type = std::vector<typename container_type::template element_type<I>>;
+
+            public:
+                using value_type = typename column_type::value_type;
+                using const_iterator = typename column_type::const_iterator;
+                using iterator = const_iterator;
+                using difference_type = typename column_type::difference_type;
+                using size_type = std::size_t;
+
+                column_view(ColumnsType &&cols) : columns_(std::forward<ColumnsType>(cols)) {}
+
+                const_iterator begin() const
+                {
+                    return column().begin();
+                }
+
+                const_iterator end() const
+                {
+                    return column().end();
+                }
+
+                const value_type *data() const
+                {
+                    return column().data();
+                }
+
+                size_type size() const
+                {
+                    return column().size();
+                }
+
+                bool empty() const
+                {
+                    return column().empty();
+                }
+
+                operator column_type() const
+                {
+                    return column();
+                }
+
+            private:
+                const column_type &column() const
+                {
+                    return static_cast<const container_type &>(columns_).template column<I>();
+                }
+
+                ColumnsType columns_;
+        };
+
+        template
+        <
+            typename ColumnsType,
+            std::size_t I
+        >
+        struct is_contiguous<column_view<ColumnsType, I>> : std::integral_constant<bool, !std::is_same<typename column_view<ColumnsType, I>::value_type, bool>::value> {};
+
+        //The selected rows of a single column, read as the view is traversed
+        template
+        <
+            typename SelectionType,
+            std::size_t I
+        >
+        class selected_column_view : public view_base
+        {
+            private:
+                using selection_type = typename std::decay<SelectionType>::type;
+                using column_type = std::vector<typename std::decay<decltype(std::declval<const selection_type &>().source())>::type::template element_type<I>>;
+                using row_iterator = std::vector<std::size_t>::const_iterator;
+
+            public:
+                using value_type = typename column_type::value_type;
+                using difference_type = std::ptrdiff_t;
+                using size_type = std::size_t;
+
+                class const_iterator
+                {
+                    public:
+                        using iterator_category = std::forward_iterator_tag;
+                        using value_type = typename column_type::value_type;
+                        using difference_type = std::ptrdiff_t;
+                        using pointer = const value_type *;
+                        using reference = const value_type &;
+
+                        const_iterator() : column_(nullptr) {}
+
+                        const_iterator(const column_type *column, row_iterator row) : column_(column), row_(row) {}
+
+                        reference operator*() const
+                        {
+                            return (*column_)[*row_];
+                        }
+
+                        pointer operator->() const
+                        {
+                            return &(*column_)[*row_];
+                        }
+
+                        const_iterator &operator++()
+                        {
+                            ++row_;
+                            return *this;
+                        }
+
+                        const_iterator operator++(int)
+                        {
+                            const_iterator it(*this);
+                            ++row_;
+                            return it;
+                        }
+
+                        bool operator==(const const_iterator &other) const
+                        {
+                            return row_ == other.row_;
+                        }
+
+                        bool operator!=(const const_iterator &other) const
+                        {
+                            return row_ != other.row_;
+                        }
+
+                    private:
+                        const column_type *column_;
+                        row_iterator row_;
+                };
+
+                using iterator = const_iterator;
+
+                selected_column_view(SelectionType &&selection) : selection_(std::forward<SelectionType>(selection)) {}
+
+                const_iterator begin() const
+                {
+                    return const_iterator(&column(), selection().rows().begin());
+                }
+
+                const_iterator end() const
+                {
+                    return const_iterator(&column(), selection().rows().end());
+                }
+
+                size_type size() const
+                {
+                    return selection().size();
+                }
+
+                bool empty() const
+                {
+                    return selection().empty();
+                }
+
+                operator column_type() const
+                {
+                    return column_type(begin(), end());
+                }
+
+            private:
+                const selection_type &selection() const
+                {
+                    return selection_;
+                }
+
+                const column_type &column() const
+                {
+                    return selection().source().template column<I>();
+                }
+
+                SelectionType selection_;
+        };
+
+        template <std::size_t I>
+        struct column_type
+        {
+            template
+            <
+                typename ColumnsType,
+                typename = typename std::enable_if<is_columns<typename std::decay<ColumnsType>::type>::value>::type
+            >
+            column_view<ColumnsType, I> operator()(ColumnsType &&cols) const
+            {
+                return column_view<ColumnsType, I>(std::forward<ColumnsType>(cols));
+            }
+
+            template
+            <
+                typename SelectionType,
+                typename = typename std::enable_if<is_column_selection<typename std::decay<SelectionType>::type>::value>::type,
+                typename = void
+            >
+            selected_column_view<SelectionType, I> operator()(SelectionType &&selection) const
+            {
+                return selected_column_view<SelectionType, I>(std::forward<SelectionType>(selection));
+            }
+        };
+
+        template
+        <
+            std::size_t I,
+            typename Predicate
+        >
+        struct where_column_type
+        {
+            constexpr where_column_type(const Predicate &pred) : pred_(pred) {}
+
+            template
+            <
+                typename ColumnsType,
+                typename = typename std::enable_if<is_columns<typename std::decay<ColumnsType>::type>::value>::type
+            >
+            column_selection<ColumnsType> operator()(ColumnsType &&cols) const
+            {
+                const auto &column = static_cast<const typename std::decay<ColumnsType>::type &>(cols).template column<I>();
+
+                std::vector<std::size_t> rows;
+                for(std::size_t i = 0; i < column.size(); ++i)
+                {
+                    if(pred_(column[i]))
+                    {
+                        rows.push_back(i);
+                    }
+                }
+
+                return column_selection<ColumnsType>(std::forward<ColumnsType>(cols), std::move(rows));
+            }
+
+            //Refines the selection, reading the column only at the rows still selected
+            template
+            <
+                typename ColumnsType
+            >
+            column_selection<ColumnsType> operator()(column_selection<ColumnsType> selection) const
+            {
+                const auto &column = selection.source().template column<I>();
+                std::vector<std::size_t> &rows = selection.rows();
+
+                auto out = rows.begin();
+                for(const std::size_t &i : rows)
+                {
+                    if(pred_(column[i]))
+                    {
+                        *out++ = i;
+                    }
+                }
+
+                rows.erase(out, rows.end());
+                return selection;
+            }
+
+            Predicate pred_;
+        };
+    }
+
+    template <std::size_t I>
+    constexpr detail::column_type<I> column()
+    {
+        return detail::column_type<I>();
+    }
+
+    template
+    <
+        std::size_t I,
+        typename Predicate
+    >
+    constexpr detail::where_column_type<I, Predicate> where_column(const Predicate &pred)
+    {
+        return detail::where_column_type<I, Predicate>(pred);
+    }
+}
+
+#endif
@@ -0,0 +1,243 @@
+#ifndef STP_FIXED_VECTOR_HPP
+#define STP_FIXED_VECTOR_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+
+#include "../traits.hpp"
+
+namespace stp
+{
+    //A sequence of at most N elements stored inline, which never allocates. Adding an element
+    //beyond the capacity throws std::length_error.
+    template
+    <
+        typename ValueType,
+        std::size_t N
+    >
+    class fixed_vector
+    {
+        static_assert(N > 0, "A fixed_vector must have a capacity of at least one element");
+
+        public:
+            using value_type = ValueType;
+            using size_type = std::size_t;
+            using difference_type = std::ptrdiff_t;
+            using reference = value_type &;
+            using const_reference = const value_type &;
+            using pointer = value_type *;
+            using const_pointer = const value_type *;
+            using iterator = pointer;
+            using const_iterator = const_pointer;
+
+            constexpr fixed_vector() : values_(), size_(0) {}
+
+            fixed_vector(std::initializer_list<value_type> values) : fixed_vector(values.begin(), values.end()) {}
+
+            template
+            <
+                typename IteratorType,
+                typename = typename std::iterator_traits<IteratorType>::iterator_category
+            >
+            fixed_vector(IteratorType first, IteratorType last) : values_(), size_(0)
+            {
+                for(; first != last; ++first)
+                {
+                    push_back(*first);
+                }
+            }
+
+            void push_back(const value_type &val)
+            {
+                if(size_ == N)
+                {
+                    throw std::length_error("fixed_vector capacity exceeded");
+                }
+
+                values_[size_++] = val;
+            }
+
+            void pop_back()
+            {
+                --size_;
+            }
+
+            iterator erase(const_iterator first, const_iterator last)
+            {
+                const iterator result = begin() + (first - cbegin());
+
+                iterator out = result;
+                for(iterator rest = begin() + (last - cbegin()); rest != end(); ++out, ++rest)
+                {
+                    *out = *rest;
+                }
+
+                size_ = static_cast<size_type>(out - begin());
+                return result;
+            }
+
+            void resize(const size_type &n)
+            {
+                if(n > N)
+                {
+                    throw std::length_error("fixed_vector capacity exceeded");
+                }
+
+                for(size_type i = size_; i < n; ++i)
+                {
+                    values_[i] = value_type();
+                }
+
+                size_ = n;
+            }
+
+            void clear()
+            {
+                size_ = 0;
+            }
+
+            iterator begin()
+            {
+                return values_;
+            }
+
+            iterator end()
+            {
+                return values_ + size_;
+            }
+
+            constexpr const_iterator begin() const
+            {
+                return values_;
+            }
+
+            constexpr const_iterator end() const
+            {
+                return values_ + size_;
+            }
+
+            constexpr const_iterator cbegin() const
+            {
+                return values_;
+            }
+
+            constexpr const_iterator cend() const
+            {
+                return values_ + size_;
+            }
+
+            pointer data()
+            {
+                return values_;
+            }
+
+            constexpr const_pointer data() const
+            {
+                return values_;
+            }
+
+            reference operator[](const size_type &i)
+            {
+                return values_[i];
+            }
+
+            constexpr const_reference operator[](const size_type &i) const
+            {
+                return values_[i];
+            }
+
+            reference front()
+            {
+                return values_[0];
+            }
+
+            constexpr const_reference front() const
+            {
+                return values_[0];
+            }
+
+            reference back()
+            {
+                return values_[size_ - 1];
+            }
+
+            constexpr const_reference back() const
+            {
+                return values_[size_ - 1];
+            }
+
+            constexpr size_type size() const
+            {
+                return size_;
+            }
+
+            constexpr bool empty() const
+            {
+                return size_ == 0;
+            }
+
+            static constexpr size_type capacity()
+            {
+                return N;
+            }
+
+        private:
+            value_type values_[N];
+            size_type size_;
+    };
+
+    template
+    <
+        typename ValueType,
+        std::size_t N
+    >
+    bool operator==(const fixed_vector<ValueType, N> &lhs, const fixed_vector<ValueType, N> &rhs)
+    {
+        return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+    }
+
+    template
+    <
+        typename ValueType,
+        std::size_t N
+    >
+    bool operator!=(const fixed_vector<ValueType, N> &lhs, const fixed_vector<ValueType, N> &rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+    namespace detail
+    {
+        template
+        <
+            typename ValueType,
+            std::size_t N
+        >
+        struct is_contiguous<fixed_vector<ValueType, N>> : std::true_type {};
+
+        template <std::size_t N>
+        struct to_fixed_vector_type
+        {
+            template
+            <
+                typename SequenceType,
+                typename ValueType = typename SequenceType::value_type
+            >
+            fixed_vector<ValueType, N> operator()(const SequenceType &sequence) const
+            {
+                return fixed_vector<ValueType, N>(std::begin(sequence), std::end(sequence));
+            }
+        };
+    }
+
+    template <std::size_t N>
+    constexpr detail::to_fixed_vector_type<N> to_fixed_vector()
+    {
+        return detail::to_fixed_vector_type<N>();
+    }
+}
+
+#endif
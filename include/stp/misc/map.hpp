@@ -4,8 +4,13 @@
 #include <algorithm>
 #include <iterator>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
+#include "../accumulator.hpp"
+#include "../traits.hpp"
+#include "bind.hpp"
+
 namespace stp
 {
     namespace detail
@@ -13,14 +18,14 @@ namespace stp
         template <typename UnaryOperation>
         struct map_type
         {
-            map_type(const UnaryOperation &unop) : unop_(unop) {}
+            constexpr map_type(const UnaryOperation &unop) : unop_(unop) {}
 
             template
             <
                 typename SequenceType,
                 typename ValueType = typename SequenceType::value_type,
                 typename OpType = typename std::result_of<UnaryOperation(ValueType)>::type,
-                typename MapType = typename std::vector<OpType>
+                typename MapType = typename std::vector<typename std::decay<OpType>::type>
             >
             MapType operator()(const SequenceType &sequence) const
             {
@@ -38,12 +43,56 @@ namespace stp
 
             UnaryOperation unop_;
         };
+
+        //Evaluates the bound transformation once, rather than once per element
+        template
+        <
+            typename InnerType,
+            typename Function
+        >
+        struct map_type<bound_type<InnerType, Function>>
+        {
+            template <typename SequenceType>
+            using call_type = typename bound_type<InnerType, Function>::template call_type<typename std::decay<SequenceType>::type>;
+
+            constexpr map_type(const bound_type<InnerType, Function> &unop) : unop_(unop) {}
+
+            template
+            <
+                typename SequenceType,
+                typename ResultType = typename std::result_of<map_type<call_type<SequenceType>>(SequenceType)>::type
+            >
+            ResultType operator()(SequenceType &&sequence) const
+            {
+                map_type<call_type<SequenceType>> op(unop_.bind(sequence));
+                return op(std::forward<SequenceType>(sequence));
+            }
+
+            bound_type<InnerType, Function> unop_;
+        };
+
+        template <typename UnaryOperation>
+        struct element_op<map_type<UnaryOperation>>
+        {
+            template <typename ValueType>
+            using output_type = typename std::decay<typename std::result_of<UnaryOperation(ValueType)>::type>::type;
+
+            template
+            <
+                typename ValueType,
+                typename NextType
+            >
+            static void apply(const map_type<UnaryOperation> &op, const ValueType &val, NextType &next)
+            {
+                next(op.unop_(val));
+            }
+        };
     }
 
     template <typename UnaryOperation>
-    detail::map_type<UnaryOperation> map(const UnaryOperation &unop)
+    constexpr detail::map_type<detail::projected_type<UnaryOperation>> map(const UnaryOperation &unop)
     {
-        return detail::map_type<UnaryOperation>(unop);
+        return detail::map_type<detail::projected_type<UnaryOperation>>(unop);
     }
 }
 
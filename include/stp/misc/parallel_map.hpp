@@ -0,0 +1,87 @@
+#ifndef STP_PARALLEL_MAP_HPP
+#define STP_PARALLEL_MAP_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+#include "map.hpp"
+#include "../parallel.hpp"
+#include "../tags.hpp"
+#include "../traits.hpp"
+
+namespace stp
+{
+    namespace detail
+    {
+        const std::size_t parallel_map_grain = 1 << 12;
+
+        //Chunks start on a multiple of 64, so chunks of a std::vector<bool> never share a word
+        const std::size_t parallel_map_align = 64;
+
+        template <typename UnaryOperation>
+        struct par_map_type
+        {
+            constexpr par_map_type(const UnaryOperation &unop) : unop_(unop) {}
+
+            template
+            <
+                typename SequenceType,
+                typename ValueType = typename SequenceType::value_type,
+                typename OpType = typename std::result_of<UnaryOperation(ValueType)>::type,
+                typename MapType = typename std::vector<typename std::decay<OpType>::type>
+            >
+            MapType operator()(const SequenceType &sequence) const
+            {
+                using IterType = decltype(std::begin(sequence));
+                using CategoryType = typename std::iterator_traits<IterType>::iterator_category;
+
+                return transform<MapType>(sequence, std::is_base_of<std::random_access_iterator_tag, CategoryType>());
+            }
+
+            template
+            <
+                typename MapType,
+                typename SequenceType
+            >
+            MapType transform(const SequenceType &sequence, std::false_type) const
+            {
+                return map_type<UnaryOperation>(unop_)(sequence);
+            }
+
+            template
+            <
+                typename MapType,
+                typename SequenceType
+            >
+            MapType transform(const SequenceType &sequence, std::true_type) const
+            {
+                auto begin = std::begin(sequence);
+                const std::size_t n = static_cast<std::size_t>(std::distance(begin, std::end(sequence)));
+
+                MapType result(n);
+                auto out = std::begin(result);
+
+                const std::vector<std::size_t> bounds = parallel_chunks(n, parallel_map_grain, parallel_map_align);
+                parallel_for(bounds.size() - 1, [&](const std::size_t &i)
+                {
+                    std::transform(begin + bounds[i], begin + bounds[i + 1], out + bounds[i], unop_);
+                });
+
+                return result;
+            }
+
+            UnaryOperation unop_;
+        };
+    }
+
+    template <typename UnaryOperation>
+    constexpr detail::par_map_type<detail::projected_type<UnaryOperation>> map(detail::par_tag, const UnaryOperation &unop)
+    {
+        return detail::par_map_type<detail::projected_type<UnaryOperation>>(unop);
+    }
+}
+
+#endif
@@ -5,9 +5,12 @@
 #include <iterator>
 #include <list>
 #include <map>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
+#include "../traits.hpp"
+
 namespace stp
 {
     namespace detail
@@ -53,28 +56,26 @@ namespace stp
             <
                 typename SequenceType,
                 typename ValueType = typename SequenceType::value_type,
-                typename VectorType = typename std::vector<ValueType>
+                typename VectorType = std::vector<typename std::conditional<is_view<SequenceType>::value, owned_type<SequenceType>, SequenceType>::type::value_type>
             >
             VectorType operator()(const SequenceType &sequence) const
             {
-                VectorType result;
-                std::for_each(std::begin(sequence), std::end(sequence), [&](const ValueType &i){result.push_back(i);});
-                return result;
+                return VectorType(std::begin(sequence), std::end(sequence));
             }
         };
     }
 
-    detail::to_list_type to_list()
+    constexpr detail::to_list_type to_list()
     {
         return detail::to_list_type();
     }
 
-    detail::to_map_type to_map()
+    constexpr detail::to_map_type to_map()
     {
         return detail::to_map_type();
     }
 
-    detail::to_vector_type to_vector()
+    constexpr detail::to_vector_type to_vector()
     {
         return detail::to_vector_type();
     }
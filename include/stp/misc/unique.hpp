@@ -4,6 +4,8 @@
 #include <algorithm>
 #include <iterator>
 
+#include "../traits.hpp"
+
 namespace stp
 {
     namespace detail
@@ -15,9 +17,9 @@ namespace stp
                 typename SequenceType,
                 typename ValueType = typename SequenceType::value_type
             >
-            SequenceType operator()(const SequenceType &sequence) const
+            owned_type<SequenceType> operator()(const SequenceType &sequence) const
             {
-                SequenceType result;
+                owned_type<SequenceType> result;
                 for(const ValueType& i : sequence)
                 {
                     if(std::find(std::begin(result), std::end(result), i) == std::end(result))
@@ -31,7 +33,7 @@ namespace stp
         };
     }
 
-    detail::unique_type unique()
+    constexpr detail::unique_type unique()
     {
         return detail::unique_type();
     }
@@ -0,0 +1,193 @@
+#ifndef STP_APPROX_DISTINCT_HPP
+#define STP_APPROX_DISTINCT_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "../accumulator.hpp"
+#include "../hash.hpp"
+
+namespace stp
+{
+    namespace detail
+    {
+        //Checked before anything is allocated, as the register count grows exponentially with precision
+        inline std::size_t hll_register_count(const unsigned &precision)
+        {
+            if(precision < 4 || precision > 18)
+            {
+                throw std::invalid_argument("Precision must be between 4 and 18");
+            }
+
+            return std::size_t(1) << precision;
+        }
+
+        class hll_sketch
+        {
+            public:
+                hll_sketch(const unsigned &precision) : precision_(precision), registers_(hll_register_count(precision), 0) {}
+
+                template <typename ValueType>
+                void insert(const ValueType &val)
+                {
+                    insert_hash(hash_value(val));
+                }
+
+                void insert_hash(std::uint64_t h)
+                {
+                    std::size_t index = static_cast<std::size_t>(h >> (64 - precision_));
+
+                    //The guard bit bounds the rank by 64 - precision + 1
+                    std::uint64_t rest = (h << precision_) | (std::uint64_t(1) << (precision_ - 1));
+                    std::uint8_t rank = 1;
+                    while((rest & (std::uint64_t(1) << 63)) == 0)
+                    {
+                        ++rank;
+                        rest <<= 1;
+                    }
+
+                    registers_[index] = std::max(registers_[index], rank);
+                }
+
+                void merge(const hll_sketch &other)
+                {
+                    if(other.precision_ != precision_)
+                    {
+                        throw std::invalid_argument("Cannot merge sketches of different precision");
+                    }
+
+                    for(std::size_t i = 0; i < registers_.size(); ++i)
+                    {
+                        registers_[i] = std::max(registers_[i], other.registers_[i]);
+                    }
+                }
+
+                double estimate() const
+                {
+                    double m = static_cast<double>(registers_.size());
+
+                    double sum = 0.0;
+                    std::size_t zeros = 0;
+                    for(std::uint8_t reg : registers_)
+                    {
+                        sum += std::ldexp(1.0, -static_cast<int>(reg));
+                        zeros += (reg == 0) ? 1 : 0;
+                    }
+
+                    double raw = alpha() * m * m / sum;
+
+                    //Linear counting is more accurate while many registers are still empty
+                    if(raw <= 2.5 * m && zeros != 0)
+                    {
+                        return m * std::log(m / static_cast<double>(zeros));
+                    }
+
+                    return raw;
+                }
+
+                double relative_error() const
+                {
+                    return 1.04 / std::sqrt(static_cast<double>(registers_.size()));
+                }
+
+                unsigned precision() const
+                {
+                    return precision_;
+                }
+
+            private:
+                double alpha() const
+                {
+                    switch(precision_)
+                    {
+                        case 4: return 0.673;
+                        case 5: return 0.697;
+                        case 6: return 0.709;
+                        default: return 0.7213 / (1.0 + 1.079 / static_cast<double>(registers_.size()));
+                    }
+                }
+
+                unsigned precision_;
+                std::vector<std::uint8_t> registers_;
+        };
+
+        struct approx_distinct_type
+        {
+            approx_distinct_type(const unsigned &precision) : precision_(precision)
+            {
+                hll_register_count(precision);
+            }
+
+            template
+            <
+                typename SequenceType,
+                typename ValueType = typename SequenceType::value_type
+            >
+            hll_sketch sketch(const SequenceType &sequence) const
+            {
+                hll_sketch result(precision_);
+                for(const ValueType &i : sequence)
+                {
+                    result.insert(i);
+                }
+                return result;
+            }
+
+            template
+            <
+                typename SequenceType,
+                typename ValueType = typename SequenceType::value_type
+            >
+            double operator()(const SequenceType &sequence) const
+            {
+                return sketch(sequence).estimate();
+            }
+
+            unsigned precision_;
+        };
+
+        template <typename ValueType>
+        struct accumulator<approx_distinct_type, ValueType>
+        {
+            using result_type = double;
+
+            accumulator(const approx_distinct_type &op) : sketch_(op.precision_) {}
+
+            void push(const ValueType &val)
+            {
+                sketch_.insert(val);
+            }
+
+            result_type result() const
+            {
+                return sketch_.estimate();
+            }
+
+            hll_sketch sketch_;
+        };
+
+        template <typename ValueType>
+        struct mergeable_accumulator<approx_distinct_type, ValueType> : accumulator<approx_distinct_type, ValueType>
+        {
+            static const bool value = true;
+
+            mergeable_accumulator(const approx_distinct_type &op) : accumulator<approx_distinct_type, ValueType>(op) {}
+
+            void merge(const mergeable_accumulator &other)
+            {
+                this->sketch_.merge(other.sketch_);
+            }
+        };
+    }
+
+    inline detail::approx_distinct_type approx_distinct(const unsigned &precision = 12)
+    {
+        return detail::approx_distinct_type(precision);
+    }
+}
+
+#endif
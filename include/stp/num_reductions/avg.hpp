@@ -1,18 +1,55 @@
 #ifndef STP_AVG_HPP
 #define STP_AVG_HPP
 
+#include <cstddef>
 #include <iterator>
 #include <stdexcept>
+#include <type_traits>
 
 #include "sum.hpp"
+#include "../accumulator.hpp"
 
 namespace stp
 {
     namespace detail
     {
+        struct avg_type;
+
+        template <typename ValueType>
+        struct accumulator<avg_type, ValueType>
+        {
+            using result_type = double;
+
+            accumulator(const avg_type &) : sum_(), size_(0) {}
+
+            void push(const ValueType &val)
+            {
+                sum_ = sum_ + val;
+                ++size_;
+            }
+
+            result_type result() const
+            {
+                if(size_ == 0)
+                {
+                    throw std::range_error("Empty sequence");
+                }
+
+                return static_cast<double>(sum_) / static_cast<double>(size_);
+            }
+
+            ValueType sum_;
+            std::size_t size_;
+        };
+
         struct avg_type
         {
-            template <typename SequenceType>
+            template
+            <
+                typename SequenceType,
+                typename IterType = decltype(std::begin(std::declval<const SequenceType &>())),
+                typename CategoryType = typename std::iterator_traits<IterType>::iterator_category
+            >
             double operator()(const SequenceType &sequence) const
             {
                 auto begin = std::begin(sequence);
@@ -23,16 +60,52 @@ namespace stp
                     throw std::range_error("Empty sequence");
                 }
 
+                return reduce(sequence, std::is_base_of<std::random_access_iterator_tag, CategoryType>());
+            }
+
+            template <typename SequenceType>
+            double reduce(const SequenceType &sequence, std::true_type) const
+            {
                 sum_type sum_obj;
-                return static_cast<double>(sum_obj(sequence)) / static_cast<double>(std::distance(begin, end));
+                return static_cast<double>(sum_obj(sequence)) / static_cast<double>(std::distance(std::begin(sequence), std::end(sequence)));
+            }
+
+            //Without random access, std::distance would be a second traversal
+            template
+            <
+                typename SequenceType,
+                typename ValueType = typename SequenceType::value_type
+            >
+            double reduce(const SequenceType &sequence, std::false_type) const
+            {
+                accumulator<avg_type, ValueType> acc(*this);
+                for(const ValueType &i : sequence)
+                {
+                    acc.push(i);
+                }
+                return acc.result();
+            }
+        };
+
+        template <typename ValueType>
+        struct reversible_accumulator<avg_type, ValueType> : accumulator<avg_type, ValueType>
+        {
+            static const bool value = std::is_integral<ValueType>::value;
+
+            reversible_accumulator(const avg_type &op) : accumulator<avg_type, ValueType>(op) {}
+
+            void pop(const ValueType &val)
+            {
+                this->sum_ = this->sum_ - val;
+                --this->size_;
             }
         };
     }
 
-    detail::avg_type avg()
+    constexpr detail::avg_type avg()
     {
         return detail::avg_type();
     }
 }
 
-#endif
\ No newline at end of file
+#endif
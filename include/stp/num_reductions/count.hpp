@@ -2,9 +2,13 @@
 #define STP_COUNT_HPP
 
 #include <algorithm>
+#include <cstddef>
 #include <iterator>
 #include <type_traits>
 
+#include "kernels.hpp"
+#include "../accumulator.hpp"
+
 namespace stp
 {
     namespace detail
@@ -12,7 +16,7 @@ namespace stp
         template <typename ElementType>
         struct count_type
         {
-            count_type(const ElementType &val) : val_(val) {}
+            constexpr count_type(const ElementType &val) : val_(val) {}
 
             template
             <
@@ -24,18 +28,78 @@ namespace stp
             >
             DiffType operator()(const SequenceType &sequence) const
             {
-                auto begin = std::begin(sequence);
-                auto end = std::end(sequence);
+                using simd_type = std::integral_constant<bool, has_simd_kernel<SequenceType>::value && std::is_same<ElementType, ValueType>::value>;
+                return reduce<SequenceType, DiffType>(sequence, simd_type());
+            }
 
-                return std::count(begin, end, val_);
+            template
+            <
+                typename SequenceType,
+                typename DiffType
+            >
+            DiffType reduce(const SequenceType &sequence, std::true_type) const
+            {
+                return static_cast<DiffType>(simd_count(sequence.data(), sequence.size(), val_));
+            }
+
+            template
+            <
+                typename SequenceType,
+                typename DiffType
+            >
+            DiffType reduce(const SequenceType &sequence, std::false_type) const
+            {
+                return std::count(std::begin(sequence), std::end(sequence), val_);
             }
 
             ElementType val_;
         };
+
+        template
+        <
+            typename ElementType,
+            typename ValueType
+        >
+        struct accumulator<count_type<ElementType>, ValueType>
+        {
+            using result_type = std::ptrdiff_t;
+
+            accumulator(const count_type<ElementType> &op) : val_(op.val_), count_(0) {}
+
+            void push(const ValueType &val)
+            {
+                count_ += (val == val_) ? 1 : 0;
+            }
+
+            result_type result() const
+            {
+                return count_;
+            }
+
+            ElementType val_;
+            std::ptrdiff_t count_;
+        };
+
+        template
+        <
+            typename ElementType,
+            typename ValueType
+        >
+        struct reversible_accumulator<count_type<ElementType>, ValueType> : accumulator<count_type<ElementType>, ValueType>
+        {
+            static const bool value = true;
+
+            reversible_accumulator(const count_type<ElementType> &op) : accumulator<count_type<ElementType>, ValueType>(op) {}
+
+            void pop(const ValueType &val)
+            {
+                this->count_ -= (val == this->val_) ? 1 : 0;
+            }
+        };
     }
 
     template <typename ElementType>
-    detail::count_type<ElementType> count(const ElementType &val)
+    constexpr detail::count_type<ElementType> count(const ElementType &val)
     {
         return detail::count_type<ElementType>(val);
     }
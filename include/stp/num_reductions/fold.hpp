@@ -5,6 +5,8 @@
 #include <numeric>
 #include <type_traits>
 
+#include "../accumulator.hpp"
+
 namespace stp
 {
     namespace detail
@@ -16,7 +18,7 @@ namespace stp
         >
         struct fold_type
         {
-            fold_type(const BinaryOperation &binop, const InitType &init) : binop_(binop), init_(init) {}
+            constexpr fold_type(const BinaryOperation &binop, const InitType &init) : binop_(binop), init_(init) {}
 
             template
             <
@@ -33,6 +35,32 @@ namespace stp
             BinaryOperation binop_;
             InitType init_;
         };
+
+        template
+        <
+            typename BinaryOperation,
+            typename InitType,
+            typename ValueType
+        >
+        struct accumulator<fold_type<BinaryOperation, InitType>, ValueType>
+        {
+            using result_type = typename std::result_of<BinaryOperation(InitType, ValueType)>::type;
+
+            accumulator(const fold_type<BinaryOperation, InitType> &op) : binop_(op.binop_), acc_(op.init_) {}
+
+            void push(const ValueType &val)
+            {
+                acc_ = binop_(acc_, val);
+            }
+
+            result_type result() const
+            {
+                return acc_;
+            }
+
+            BinaryOperation binop_;
+            InitType acc_;
+        };
     }
 
     template
@@ -40,7 +68,7 @@ namespace stp
         typename BinaryOperation,
         typename InitType
     >
-    detail::fold_type<BinaryOperation, InitType> fold(const BinaryOperation &binop, const InitType &init)
+    constexpr detail::fold_type<BinaryOperation, InitType> fold(const BinaryOperation &binop, const InitType &init)
     {
         return detail::fold_type<BinaryOperation, InitType>(binop, init);
     }
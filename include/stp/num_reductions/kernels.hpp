@@ -0,0 +1,263 @@
+#ifndef STP_KERNELS_HPP
+#define STP_KERNELS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "../traits.hpp"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && !defined(STP_NO_SIMD_DISPATCH)
+#define STP_SIMD_DISPATCH
+#endif
+
+#if defined(__GNUC__)
+#define STP_ALWAYS_INLINE inline __attribute__((always_inline))
+#else
+#define STP_ALWAYS_INLINE inline
+#endif
+
+namespace stp
+{
+    namespace detail
+    {
+        template <typename ValueType>
+        struct is_simd_arithmetic : std::integral_constant<bool, std::is_arithmetic<ValueType>::value && !std::is_same<ValueType, bool>::value> {};
+
+        template
+        <
+            typename SequenceType,
+            typename ValueType = typename SequenceType::value_type
+        >
+        struct has_simd_kernel : std::integral_constant<bool, is_contiguous<SequenceType>::value && is_simd_arithmetic<ValueType>::value> {};
+
+        //Enough independent lanes to fill four 256-bit registers, which hides
+        //the latency of the vector add and compare instructions
+        template <typename ValueType>
+        struct kernel_lanes : std::integral_constant<std::size_t, (128 / sizeof(ValueType) > 32) ? 32 : 128 / sizeof(ValueType)> {};
+
+        //The kernels are written as plain loops over independent lanes and
+        //left to the auto-vectorizer, once per instruction set below
+        template <typename ValueType>
+        STP_ALWAYS_INLINE ValueType sum_kernel(const ValueType *data, std::size_t n)
+        {
+            const std::size_t lanes = kernel_lanes<ValueType>::value;
+
+            ValueType result = ValueType();
+            std::size_t i = 0;
+
+            if(n >= lanes)
+            {
+                ValueType acc[lanes] = {};
+                for(;i + lanes <= n; i += lanes)
+                {
+                    for(std::size_t j = 0; j < lanes; ++j)
+                    {
+                        acc[j] += data[i + j];
+                    }
+                }
+
+                for(std::size_t j = 0; j < lanes; ++j)
+                {
+                    result += acc[j];
+                }
+            }
+
+            for(;i < n; ++i)
+            {
+                result += data[i];
+            }
+            return result;
+        }
+
+        template <typename ValueType>
+        STP_ALWAYS_INLINE ValueType min_kernel(const ValueType *data, std::size_t n)
+        {
+            const std::size_t lanes = kernel_lanes<ValueType>::value;
+
+            ValueType result = data[0];
+            std::size_t i = 0;
+
+            if(n >= lanes)
+            {
+                ValueType acc[lanes];
+                for(std::size_t j = 0; j < lanes; ++j)
+                {
+                    acc[j] = data[j];
+                }
+
+                for(i = lanes; i + lanes <= n; i += lanes)
+                {
+                    for(std::size_t j = 0; j < lanes; ++j)
+                    {
+                        acc[j] = data[i + j] < acc[j] ? data[i + j] : acc[j];
+                    }
+                }
+
+                result = acc[0];
+                for(std::size_t j = 1; j < lanes; ++j)
+                {
+                    result = acc[j] < result ? acc[j] : result;
+                }
+            }
+
+            for(;i < n; ++i)
+            {
+                result = data[i] < result ? data[i] : result;
+            }
+            return result;
+        }
+
+        template <typename ValueType>
+        STP_ALWAYS_INLINE ValueType max_kernel(const ValueType *data, std::size_t n)
+        {
+            const std::size_t lanes = kernel_lanes<ValueType>::value;
+
+            ValueType result = data[0];
+            std::size_t i = 0;
+
+            if(n >= lanes)
+            {
+                ValueType acc[lanes];
+                for(std::size_t j = 0; j < lanes; ++j)
+                {
+                    acc[j] = data[j];
+                }
+
+                for(i = lanes; i + lanes <= n; i += lanes)
+                {
+                    for(std::size_t j = 0; j < lanes; ++j)
+                    {
+                        acc[j] = acc[j] < data[i + j] ? data[i + j] : acc[j];
+                    }
+                }
+
+                result = acc[0];
+                for(std::size_t j = 1; j < lanes; ++j)
+                {
+                    result = result < acc[j] ? acc[j] : result;
+                }
+            }
+
+            for(;i < n; ++i)
+            {
+                result = result < data[i] ? data[i] : result;
+            }
+            return result;
+        }
+
+        template <typename ValueType>
+        STP_ALWAYS_INLINE std::size_t count_kernel(const ValueType *data, std::size_t n, ValueType val)
+        {
+            const std::size_t lanes = kernel_lanes<ValueType>::value;
+
+            std::size_t result = 0;
+            std::size_t i = 0;
+
+            if(n >= lanes)
+            {
+                std::size_t acc[lanes] = {};
+                for(;i + lanes <= n; i += lanes)
+                {
+                    for(std::size_t j = 0; j < lanes; ++j)
+                    {
+                        acc[j] += (data[i + j] == val) ? 1 : 0;
+                    }
+                }
+
+                for(std::size_t j = 0; j < lanes; ++j)
+                {
+                    result += acc[j];
+                }
+            }
+
+            for(;i < n; ++i)
+            {
+                result += (data[i] == val) ? 1 : 0;
+            }
+            return result;
+        }
+
+#ifdef STP_SIMD_DISPATCH
+        inline bool cpu_has_avx2()
+        {
+            static const bool result = __builtin_cpu_supports("avx2");
+            return result;
+        }
+
+        template <typename ValueType>
+        __attribute__((target("avx2"))) ValueType sum_avx2(const ValueType *data, std::size_t n)
+        {
+            return sum_kernel(data, n);
+        }
+
+        template <typename ValueType>
+        __attribute__((target("avx2"))) ValueType min_avx2(const ValueType *data, std::size_t n)
+        {
+            return min_kernel(data, n);
+        }
+
+        template <typename ValueType>
+        __attribute__((target("avx2"))) ValueType max_avx2(const ValueType *data, std::size_t n)
+        {
+            return max_kernel(data, n);
+        }
+
+        template <typename ValueType>
+        __attribute__((target("avx2"))) std::size_t count_avx2(const ValueType *data, std::size_t n, ValueType val)
+        {
+            return count_kernel(data, n, val);
+        }
+#endif
+
+        template <typename ValueType>
+        ValueType simd_sum(const ValueType *data, std::size_t n)
+        {
+#ifdef STP_SIMD_DISPATCH
+            if(cpu_has_avx2())
+            {
+                return sum_avx2(data, n);
+            }
+#endif
+            return sum_kernel(data, n);
+        }
+
+        template <typename ValueType>
+        ValueType simd_min(const ValueType *data, std::size_t n)
+        {
+#ifdef STP_SIMD_DISPATCH
+            if(cpu_has_avx2())
+            {
+                return min_avx2(data, n);
+            }
+#endif
+            return min_kernel(data, n);
+        }
+
+        template <typename ValueType>
+        ValueType simd_max(const ValueType *data, std::size_t n)
+        {
+#ifdef STP_SIMD_DISPATCH
+            if(cpu_has_avx2())
+            {
+                return max_avx2(data, n);
+            }
+#endif
+            return max_kernel(data, n);
+        }
+
+        template <typename ValueType>
+        std::size_t simd_count(const ValueType *data, std::size_t n, ValueType val)
+        {
+#ifdef STP_SIMD_DISPATCH
+            if(cpu_has_avx2())
+            {
+                return count_avx2(data, n, val);
+            }
+#endif
+            return count_kernel(data, n, val);
+        }
+    }
+}
+
+#endif
@@ -4,6 +4,10 @@
 #include <algorithm>
 #include <iterator>
 #include <stdexcept>
+#include <type_traits>
+
+#include "kernels.hpp"
+#include "../accumulator.hpp"
 
 namespace stp
 {
@@ -26,12 +30,62 @@ namespace stp
                     throw std::range_error("Empty sequence");
                 }
 
-                return *std::max_element(begin, end);
+                return reduce(sequence, has_simd_kernel<SequenceType>());
+            }
+
+            template
+            <
+                typename SequenceType,
+                typename ValueType = typename SequenceType::value_type
+            >
+            ValueType reduce(const SequenceType &sequence, std::true_type) const
+            {
+                return simd_max(sequence.data(), sequence.size());
+            }
+
+            template
+            <
+                typename SequenceType,
+                typename ValueType = typename SequenceType::value_type
+            >
+            ValueType reduce(const SequenceType &sequence, std::false_type) const
+            {
+                return *std::max_element(std::begin(sequence), std::end(sequence));
+            }
+        };
+
+        template <typename ValueType>
+        struct accumulator<max_type, ValueType>
+        {
+            using result_type = ValueType;
+
+            accumulator(const max_type &) : empty_(true), value_() {}
+
+            void push(const ValueType &val)
+            {
+                if(empty_ || value_ < val)
+                {
+                    value_ = val;
+                    empty_ = false;
+                }
+            }
+
+            result_type result() const
+            {
+                if(empty_)
+                {
+                    throw std::range_error("Empty sequence");
+                }
+
+                return value_;
             }
+
+            bool empty_;
+            ValueType value_;
         };
     }
 
-    detail::max_type max()
+    constexpr detail::max_type max()
     {
         return detail::max_type();
     }
@@ -0,0 +1,92 @@
+#ifndef STP_PARALLEL_REDUCE_HPP
+#define STP_PARALLEL_REDUCE_HPP
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+#include "../accumulator.hpp"
+#include "../parallel.hpp"
+#include "../tags.hpp"
+
+namespace stp
+{
+    namespace detail
+    {
+        const std::size_t parallel_reduce_grain = 1 << 12;
+
+        //Each chunk is pushed into an accumulator of its own, and the accumulators are then merged in order
+        template <typename OpType>
+        struct par_reduce_type
+        {
+            constexpr par_reduce_type(const OpType &op) : op_(op) {}
+
+            template
+            <
+                typename SequenceType,
+                typename ValueType = typename SequenceType::value_type,
+                typename ResultType = typename std::result_of<const OpType(const SequenceType &)>::type
+            >
+            ResultType operator()(const SequenceType &sequence) const
+            {
+                using IterType = decltype(std::begin(sequence));
+                using CategoryType = typename std::iterator_traits<IterType>::iterator_category;
+
+                return reduce<ValueType, ResultType>(sequence, std::integral_constant<bool, std::is_base_of<std::random_access_iterator_tag, CategoryType>::value &&
+                                                                                            mergeable_accumulator<OpType, ValueType>::value>());
+            }
+
+            template
+            <
+                typename ValueType,
+                typename ResultType,
+                typename SequenceType
+            >
+            ResultType reduce(const SequenceType &sequence, std::false_type) const
+            {
+                return op_(sequence);
+            }
+
+            template
+            <
+                typename ValueType,
+                typename ResultType,
+                typename SequenceType
+            >
+            ResultType reduce(const SequenceType &sequence, std::true_type) const
+            {
+                auto begin = std::begin(sequence);
+                const std::size_t n = static_cast<std::size_t>(std::distance(begin, std::end(sequence)));
+
+                const std::vector<std::size_t> bounds = parallel_chunks(n, parallel_reduce_grain);
+                std::vector<mergeable_accumulator<OpType, ValueType>> partial(bounds.size() - 1, mergeable_accumulator<OpType, ValueType>(op_));
+
+                parallel_for(partial.size(), [&](const std::size_t &i)
+                {
+                    for(std::size_t j = bounds[i]; j < bounds[i + 1]; ++j)
+                    {
+                        partial[i].push(begin[j]);
+                    }
+                });
+
+                for(std::size_t i = 1; i < partial.size(); ++i)
+                {
+                    partial.front().merge(partial[i]);
+                }
+
+                return partial.front().result();
+            }
+
+            OpType op_;
+        };
+    }
+
+    template <typename OpType>
+    constexpr detail::par_reduce_type<OpType> reduce(detail::par_tag, const OpType &op)
+    {
+        return detail::par_reduce_type<OpType>(op);
+    }
+}
+
+#endif
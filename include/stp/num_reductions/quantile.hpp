@@ -0,0 +1,461 @@
+#ifndef STP_QUANTILE_HPP
+#define STP_QUANTILE_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "../accumulator.hpp"
+#include "../tags.hpp"
+
+namespace stp
+{
+    namespace detail
+    {
+        //Merging t-digest: centroids near the tails are kept small, so extreme
+        //quantiles stay accurate while memory is bounded by the compression.
+        //The const members never modify the digest, so it can be read from
+        //several threads at once; they are fastest after compress().
+        class tdigest
+        {
+            public:
+                tdigest(const double &compression) :
+                    compression_(compression),
+                    total_weight_(0.0),
+                    min_(std::numeric_limits<double>::infinity()),
+                    max_(-std::numeric_limits<double>::infinity())
+                {
+                    if(!(compression > 0.0))
+                    {
+                        throw std::invalid_argument("Compression must be positive");
+                    }
+                }
+
+                void insert(const double &val)
+                {
+                    buffer_.push_back(centroid(val, 1.0));
+                    total_weight_ += 1.0;
+                    min_ = std::min(min_, val);
+                    max_ = std::max(max_, val);
+
+                    if(buffer_.size() >= buffer_limit())
+                    {
+                        compress();
+                    }
+                }
+
+                void merge(const tdigest &other)
+                {
+                    buffer_.insert(std::end(buffer_), std::begin(other.centroids_), std::end(other.centroids_));
+                    buffer_.insert(std::end(buffer_), std::begin(other.buffer_), std::end(other.buffer_));
+                    total_weight_ += other.total_weight_;
+                    min_ = std::min(min_, other.min_);
+                    max_ = std::max(max_, other.max_);
+                    compress();
+                }
+
+                double quantile(const double &q) const
+                {
+                    if(total_weight_ == 0.0)
+                    {
+                        throw std::range_error("Empty sequence");
+                    }
+
+                    //Buffered values are merged into a copy rather than into this digest
+                    if(!buffer_.empty())
+                    {
+                        tdigest flushed(*this);
+                        flushed.compress();
+                        return flushed.quantile(q);
+                    }
+
+                    if(q <= 0.0)
+                    {
+                        return min_;
+                    }
+
+                    if(q >= 1.0)
+                    {
+                        return max_;
+                    }
+
+                    if(centroids_.size() == 1)
+                    {
+                        return centroids_.front().mean;
+                    }
+
+                    double index = q * total_weight_;
+
+                    const centroid &first = centroids_.front();
+                    if(index < first.weight / 2.0)
+                    {
+                        return min_ + (index / (first.weight / 2.0)) * (first.mean - min_);
+                    }
+
+                    double cumulative = first.weight / 2.0;
+                    for(std::size_t i = 0; i + 1 < centroids_.size(); ++i)
+                    {
+                        const centroid &left = centroids_[i];
+                        const centroid &right = centroids_[i + 1];
+                        double span = (left.weight + right.weight) / 2.0;
+
+                        if(cumulative + span > index)
+                        {
+                            double t = (index - cumulative) / span;
+                            return left.mean + t * (right.mean - left.mean);
+                        }
+
+                        cumulative += span;
+                    }
+
+                    const centroid &last = centroids_.back();
+                    double t = (index - cumulative) / (last.weight / 2.0);
+                    return std::min(max_, last.mean + t * (max_ - last.mean));
+                }
+
+                double total_weight() const
+                {
+                    return total_weight_;
+                }
+
+                std::size_t centroid_count() const
+                {
+                    if(!buffer_.empty())
+                    {
+                        tdigest flushed(*this);
+                        flushed.compress();
+                        return flushed.centroid_count();
+                    }
+
+                    return centroids_.size();
+                }
+
+                //Merges the buffered values into the centroids
+                void compress()
+                {
+                    if(buffer_.empty())
+                    {
+                        return;
+                    }
+
+                    buffer_.insert(std::end(buffer_), std::begin(centroids_), std::end(centroids_));
+                    std::sort(std::begin(buffer_), std::end(buffer_), [](const centroid &a, const centroid &b){return a.mean < b.mean;});
+
+                    centroids_.clear();
+
+                    centroid current = buffer_.front();
+                    double so_far = 0.0;
+                    for(std::size_t i = 1; i < buffer_.size(); ++i)
+                    {
+                        const centroid &next = buffer_[i];
+                        double proposed = current.weight + next.weight;
+                        double q = (so_far + proposed / 2.0) / total_weight_;
+                        double limit = 4.0 * total_weight_ * q * (1.0 - q) / compression_;
+
+                        if(proposed <= limit)
+                        {
+                            current.mean += (next.mean - current.mean) * next.weight / proposed;
+                            current.weight = proposed;
+                        }
+                        else
+                        {
+                            so_far += current.weight;
+                            centroids_.push_back(current);
+                            current = next;
+                        }
+                    }
+                    centroids_.push_back(current);
+
+                    buffer_.clear();
+                }
+
+            private:
+                struct centroid
+                {
+                    centroid(const double &m, const double &w) : mean(m), weight(w) {}
+
+                    double mean;
+                    double weight;
+                };
+
+                std::size_t buffer_limit() const
+                {
+                    return static_cast<std::size_t>(std::ceil(compression_ * 5.0));
+                }
+
+                double compression_;
+                double total_weight_;
+                double min_;
+                double max_;
+                std::vector<centroid> centroids_;
+                std::vector<centroid> buffer_;
+        };
+
+        inline void check_quantile(const double &q)
+        {
+            if(!(q >= 0.0 && q <= 1.0))
+            {
+                throw std::invalid_argument("Quantile must be between 0 and 1");
+            }
+        }
+
+        struct quantiles_type
+        {
+            quantiles_type(const std::vector<double> &qs, const double &compression) : qs_(qs), compression_(compression)
+            {
+                std::for_each(std::begin(qs_), std::end(qs_), check_quantile);
+            }
+
+            template
+            <
+                typename SequenceType,
+                typename ValueType = typename SequenceType::value_type,
+                typename = typename std::enable_if<std::is_arithmetic<ValueType>::value>::type
+            >
+            tdigest sketch(const SequenceType &sequence) const
+            {
+                tdigest result(compression_);
+                for(const ValueType &i : sequence)
+                {
+                    result.insert(static_cast<double>(i));
+                }
+                return result;
+            }
+
+            template
+            <
+                typename SequenceType,
+                typename ValueType = typename SequenceType::value_type,
+                typename = typename std::enable_if<std::is_arithmetic<ValueType>::value>::type
+            >
+            std::vector<double> operator()(const SequenceType &sequence) const
+            {
+                tdigest digest = sketch(sequence);
+                digest.compress();
+
+                std::vector<double> result;
+                result.reserve(qs_.size());
+                for(double q : qs_)
+                {
+                    result.push_back(digest.quantile(q));
+                }
+                return result;
+            }
+
+            std::vector<double> qs_;
+            double compression_;
+        };
+
+        struct exact_quantiles_type
+        {
+            exact_quantiles_type(const std::vector<double> &qs) : qs_(qs)
+            {
+                std::for_each(std::begin(qs_), std::end(qs_), check_quantile);
+            }
+
+            template
+            <
+                typename SequenceType,
+                typename ValueType = typename SequenceType::value_type,
+                typename = typename std::enable_if<std::is_arithmetic<ValueType>::value>::type
+            >
+            std::vector<double> operator()(const SequenceType &sequence) const
+            {
+                std::vector<double> values(std::begin(sequence), std::end(sequence));
+
+                if(values.empty())
+                {
+                    throw std::range_error("Empty sequence");
+                }
+
+                //Visiting the quantiles in ascending order lets each selection
+                //start where the previous one left off
+                std::vector<std::size_t> order(qs_.size());
+                for(std::size_t i = 0; i < order.size(); ++i)
+                {
+                    order[i] = i;
+                }
+                std::sort(std::begin(order), std::end(order), [&](std::size_t a, std::size_t b){return qs_[a] < qs_[b];});
+
+                std::vector<double> result(qs_.size());
+                auto first = std::begin(values);
+                for(std::size_t i : order)
+                {
+                    double h = qs_[i] * static_cast<double>(values.size() - 1);
+                    std::size_t lo = static_cast<std::size_t>(std::floor(h));
+                    auto nth = std::begin(values) + lo;
+
+                    std::nth_element(first, nth, std::end(values));
+                    first = nth;
+
+                    double frac = h - static_cast<double>(lo);
+                    if(frac > 0.0)
+                    {
+                        double upper = *std::min_element(nth + 1, std::end(values));
+                        result[i] = *nth + frac * (upper - *nth);
+                    }
+                    else
+                    {
+                        result[i] = *nth;
+                    }
+                }
+                return result;
+            }
+
+            std::vector<double> qs_;
+        };
+
+        struct approx_quantile_type
+        {
+            approx_quantile_type(const double &q, const double &compression) : quantiles_(std::vector<double>(1, q), compression) {}
+
+            template
+            <
+                typename SequenceType,
+                typename ValueType = typename SequenceType::value_type,
+                typename = typename std::enable_if<std::is_arithmetic<ValueType>::value>::type
+            >
+            tdigest sketch(const SequenceType &sequence) const
+            {
+                return quantiles_.sketch(sequence);
+            }
+
+            template
+            <
+                typename SequenceType,
+                typename ValueType = typename SequenceType::value_type,
+                typename = typename std::enable_if<std::is_arithmetic<ValueType>::value>::type
+            >
+            double operator()(const SequenceType &sequence) const
+            {
+                return quantiles_(sequence).front();
+            }
+
+            quantiles_type quantiles_;
+        };
+
+        template <typename ValueType>
+        struct accumulator<quantiles_type, ValueType>
+        {
+            static_assert(std::is_arithmetic<ValueType>::value, "Quantiles require an arithmetic element type");
+
+            using result_type = std::vector<double>;
+
+            accumulator(const quantiles_type &op) : qs_(op.qs_), digest_(op.compression_) {}
+
+            void push(const ValueType &val)
+            {
+                digest_.insert(static_cast<double>(val));
+            }
+
+            result_type result() const
+            {
+                tdigest digest(digest_);
+                digest.compress();
+
+                result_type result;
+                result.reserve(qs_.size());
+                for(double q : qs_)
+                {
+                    result.push_back(digest.quantile(q));
+                }
+                return result;
+            }
+
+            std::vector<double> qs_;
+            tdigest digest_;
+        };
+
+        template <typename ValueType>
+        struct accumulator<approx_quantile_type, ValueType>
+        {
+            using result_type = double;
+
+            accumulator(const approx_quantile_type &op) : acc_(op.quantiles_) {}
+
+            void push(const ValueType &val)
+            {
+                acc_.push(val);
+            }
+
+            result_type result() const
+            {
+                return acc_.result().front();
+            }
+
+            accumulator<quantiles_type, ValueType> acc_;
+        };
+
+        template <typename ValueType>
+        struct mergeable_accumulator<quantiles_type, ValueType> : accumulator<quantiles_type, ValueType>
+        {
+            static const bool value = true;
+
+            mergeable_accumulator(const quantiles_type &op) : accumulator<quantiles_type, ValueType>(op) {}
+
+            void merge(const mergeable_accumulator &other)
+            {
+                this->digest_.merge(other.digest_);
+            }
+        };
+
+        template <typename ValueType>
+        struct mergeable_accumulator<approx_quantile_type, ValueType> : accumulator<approx_quantile_type, ValueType>
+        {
+            static const bool value = true;
+
+            mergeable_accumulator(const approx_quantile_type &op) : accumulator<approx_quantile_type, ValueType>(op) {}
+
+            void merge(const mergeable_accumulator &other)
+            {
+                this->acc_.digest_.merge(other.acc_.digest_);
+            }
+        };
+
+        //Exact quantiles need every element, so they are kept until the result is asked for
+        template <typename ValueType>
+        struct accumulator<exact_quantiles_type, ValueType>
+        {
+            static_assert(std::is_arithmetic<ValueType>::value, "Quantiles require an arithmetic element type");
+
+            using result_type = std::vector<double>;
+
+            accumulator(const exact_quantiles_type &op) : op_(op) {}
+
+            void push(const ValueType &val)
+            {
+                values_.push_back(static_cast<double>(val));
+            }
+
+            result_type result() const
+            {
+                return op_(values_);
+            }
+
+            exact_quantiles_type op_;
+            std::vector<double> values_;
+        };
+    }
+
+    inline detail::approx_quantile_type approx_quantile(const double &q, const double &compression = 100.0)
+    {
+        return detail::approx_quantile_type(q, compression);
+    }
+
+    inline detail::quantiles_type quantiles(const std::vector<double> &qs, const double &compression = 100.0)
+    {
+        return detail::quantiles_type(qs, compression);
+    }
+
+    inline detail::exact_quantiles_type quantiles(const std::vector<double> &qs, detail::exact_tag)
+    {
+        return detail::exact_quantiles_type(qs);
+    }
+}
+
+#endif
@@ -0,0 +1,63 @@
+#ifndef STP_REDUCE_ALL_HPP
+#define STP_REDUCE_ALL_HPP
+
+#include <tuple>
+
+#include "../accumulator.hpp"
+
+namespace stp
+{
+    namespace detail
+    {
+        template <typename ...OpTypes>
+        struct reduce_all_type
+        {
+            reduce_all_type(const OpTypes &...ops) : ops_(ops...) {}
+
+            template
+            <
+                typename SequenceType,
+                typename ValueType = typename SequenceType::value_type,
+                typename ResultType = std::tuple<typename accumulator<OpTypes, ValueType>::result_type...>
+            >
+            ResultType operator()(const SequenceType &sequence) const
+            {
+                return reduce<ValueType, ResultType>(sequence, typename make_index_sequence<sizeof...(OpTypes)>::type());
+            }
+
+            template
+            <
+                typename ValueType,
+                typename ResultType,
+                typename SequenceType,
+                std::size_t ...I
+            >
+            ResultType reduce(const SequenceType &sequence, index_sequence<I...>) const
+            {
+                std::tuple<accumulator<OpTypes, ValueType>...> accs(accumulator<OpTypes, ValueType>(std::get<I>(ops_))...);
+
+                for(const ValueType &i : sequence)
+                {
+                    int expand[] = {(std::get<I>(accs).push(i), 0)...};
+                    (void)expand;
+                }
+
+                return ResultType(std::get<I>(accs).result()...);
+            }
+
+            std::tuple<OpTypes...> ops_;
+        };
+    }
+
+    template
+    <
+        typename OpType,
+        typename ...Rest
+    >
+    detail::reduce_all_type<OpType, Rest...> reduce_all(const OpType &op, const Rest &...rest)
+    {
+        return detail::reduce_all_type<OpType, Rest...>(op, rest...);
+    }
+}
+
+#endif
@@ -1,9 +1,13 @@
 #ifndef STP_SIZE_HPP
 #define STP_SIZE_HPP
 
+#include <cstddef>
 #include <iterator>
 #include <type_traits>
 
+#include "../accumulator.hpp"
+#include "../filters/selection.hpp"
+
 namespace stp
 {
     namespace detail
@@ -18,15 +22,58 @@ namespace stp
             >
             DiffType operator()(const SequenceType &sequence) const
             {
-                auto begin = std::begin(sequence);
-                auto end = std::end(sequence);
+                return count(sequence, is_selection<SequenceType>());
+            }
+
+            template <typename SequenceType>
+            std::ptrdiff_t count(const SequenceType &sequence, std::false_type) const
+            {
+                return std::distance(std::begin(sequence), std::end(sequence));
+            }
+
+            //The number of selected elements is kept up to date from the bitmap
+            template <typename SequenceType>
+            std::ptrdiff_t count(const SequenceType &sequence, std::true_type) const
+            {
+                return static_cast<std::ptrdiff_t>(sequence.size());
+            }
+        };
+
+        template <typename ValueType>
+        struct accumulator<size_type, ValueType>
+        {
+            using result_type = std::ptrdiff_t;
+
+            accumulator(const size_type &) : size_(0) {}
+
+            void push(const ValueType &)
+            {
+                ++size_;
+            }
+
+            result_type result() const
+            {
+                return size_;
+            }
 
-                return std::distance(begin, end);
+            std::ptrdiff_t size_;
+        };
+
+        template <typename ValueType>
+        struct reversible_accumulator<size_type, ValueType> : accumulator<size_type, ValueType>
+        {
+            static const bool value = true;
+
+            reversible_accumulator(const size_type &op) : accumulator<size_type, ValueType>(op) {}
+
+            void pop(const ValueType &)
+            {
+                --this->size_;
             }
         };
     }
 
-    detail::size_type size()
+    constexpr detail::size_type size()
     {
         return detail::size_type();
     }
@@ -0,0 +1,144 @@
+#ifndef STP_STATS_HPP
+#define STP_STATS_HPP
+
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+
+#include "../accumulator.hpp"
+
+namespace stp
+{
+    namespace detail
+    {
+        template <typename ValueType>
+        struct stats_result
+        {
+            std::size_t count;
+            double sum;
+            double mean;
+            ValueType min;
+            ValueType max;
+            double variance;
+        };
+
+        struct stats_type;
+
+        //Welford's method keeps the variance numerically stable in one pass
+        template <typename ValueType>
+        struct accumulator<stats_type, ValueType>
+        {
+            using result_type = stats_result<ValueType>;
+
+            accumulator(const stats_type &) : count_(0), sum_(0.0), mean_(0.0), m2_(0.0), min_(), max_() {}
+
+            void push(const ValueType &val)
+            {
+                double x = static_cast<double>(val);
+
+                if(count_ == 0 || val < min_)
+                {
+                    min_ = val;
+                }
+
+                if(count_ == 0 || max_ < val)
+                {
+                    max_ = val;
+                }
+
+                ++count_;
+                sum_ += x;
+
+                double delta = x - mean_;
+                mean_ += delta / static_cast<double>(count_);
+                m2_ += delta * (x - mean_);
+            }
+
+            result_type result() const
+            {
+                if(count_ == 0)
+                {
+                    throw std::range_error("Empty sequence");
+                }
+
+                result_type result;
+                result.count = count_;
+                result.sum = sum_;
+                result.mean = mean_;
+                result.min = min_;
+                result.max = max_;
+                result.variance = m2_ / static_cast<double>(count_);
+                return result;
+            }
+
+            std::size_t count_;
+            double sum_;
+            double mean_;
+            double m2_;
+            ValueType min_;
+            ValueType max_;
+        };
+
+        //Combines the partial means and squared deviations with Chan's formula
+        template <typename ValueType>
+        struct mergeable_accumulator<stats_type, ValueType> : accumulator<stats_type, ValueType>
+        {
+            static const bool value = true;
+
+            mergeable_accumulator(const stats_type &op) : accumulator<stats_type, ValueType>(op) {}
+
+            void merge(const mergeable_accumulator &other)
+            {
+                if(other.count_ == 0)
+                {
+                    return;
+                }
+
+                if(this->count_ == 0 || other.min_ < this->min_)
+                {
+                    this->min_ = other.min_;
+                }
+
+                if(this->count_ == 0 || this->max_ < other.max_)
+                {
+                    this->max_ = other.max_;
+                }
+
+                const double n = static_cast<double>(this->count_);
+                const double m = static_cast<double>(other.count_);
+                const double delta = other.mean_ - this->mean_;
+
+                this->count_ += other.count_;
+                this->sum_ += other.sum_;
+                this->mean_ += delta * m / (n + m);
+                this->m2_ += other.m2_ + delta * delta * n * m / (n + m);
+            }
+        };
+
+        struct stats_type
+        {
+            template
+            <
+                typename SequenceType,
+                typename ValueType = typename SequenceType::value_type,
+                typename = typename std::enable_if<std::is_arithmetic<ValueType>::value>::type
+            >
+            stats_result<ValueType> operator()(const SequenceType &sequence) const
+            {
+                accumulator<stats_type, ValueType> acc(*this);
+                for(const ValueType &i : sequence)
+                {
+                    acc.push(i);
+                }
+                return acc.result();
+            }
+        };
+    }
+
+    inline detail::stats_type stats()
+    {
+        return detail::stats_type();
+    }
+}
+
+#endif
@@ -5,6 +5,9 @@
 #include <numeric>
 #include <type_traits>
 
+#include "kernels.hpp"
+#include "../accumulator.hpp"
+
 namespace stp
 {
     namespace detail
@@ -18,13 +21,68 @@ namespace stp
                 typename = typename std::enable_if<std::is_default_constructible<ValueType>::value>::type
             >
             ValueType operator()(const SequenceType &sequence) const
+            {
+                //Compilers already vectorize std::accumulate over integers, which is as fast as the kernel
+                return reduce(sequence, std::integral_constant<bool, has_simd_kernel<SequenceType>::value && std::is_floating_point<ValueType>::value>());
+            }
+
+            template
+            <
+                typename SequenceType,
+                typename ValueType = typename SequenceType::value_type
+            >
+            ValueType reduce(const SequenceType &sequence, std::true_type) const
+            {
+                return simd_sum(sequence.data(), sequence.size());
+            }
+
+            template
+            <
+                typename SequenceType,
+                typename ValueType = typename SequenceType::value_type
+            >
+            ValueType reduce(const SequenceType &sequence, std::false_type) const
             {
                 return std::accumulate(std::begin(sequence), std::end(sequence), ValueType(), std::plus<ValueType>());
             }
         };
+
+        template <typename ValueType>
+        struct accumulator<sum_type, ValueType>
+        {
+            using result_type = ValueType;
+
+            accumulator(const sum_type &) : sum_() {}
+
+            void push(const ValueType &val)
+            {
+                sum_ = sum_ + val;
+            }
+
+            result_type result() const
+            {
+                return sum_;
+            }
+
+            ValueType sum_;
+        };
+
+        template <typename ValueType>
+        struct reversible_accumulator<sum_type, ValueType> : accumulator<sum_type, ValueType>
+        {
+            //Subtracting does not undo an addition in floating point, so only integers are removed this way
+            static const bool value = std::is_integral<ValueType>::value;
+
+            reversible_accumulator(const sum_type &op) : accumulator<sum_type, ValueType>(op) {}
+
+            void pop(const ValueType &val)
+            {
+                this->sum_ = this->sum_ - val;
+            }
+        };
     }
 
-    detail::sum_type sum()
+    constexpr detail::sum_type sum()
     {
         return detail::sum_type();
     }
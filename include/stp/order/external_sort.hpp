@@ -0,0 +1,429 @@
+#ifndef STP_EXTERNAL_SORT_HPP
+#define STP_EXTERNAL_SORT_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <queue>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#endif
+
+#include "sort.hpp"
+#include "../traits.hpp"
+
+namespace stp
+{
+    namespace detail
+    {
+        //Runs are stored as the raw bytes of their elements, without any header
+        template <typename ValueType>
+        class run_reader
+        {
+            public:
+                run_reader(const std::string &path, const std::size_t &block_size) : stream_(path.c_str(), std::ios::binary), block_(block_size), pos_(0), size_(0)
+                {
+                    if(!stream_)
+                    {
+                        throw std::runtime_error("Unable to open temporary file " + path);
+                    }
+                }
+
+                bool next(ValueType &val)
+                {
+                    if(pos_ == size_)
+                    {
+                        stream_.read(reinterpret_cast<char *>(block_.data()), static_cast<std::streamsize>(block_.size() * sizeof(ValueType)));
+                        size_ = static_cast<std::size_t>(stream_.gcount()) / sizeof(ValueType);
+                        pos_ = 0;
+
+                        if(size_ == 0)
+                        {
+                            return false;
+                        }
+                    }
+
+                    val = block_[pos_++];
+                    return true;
+                }
+
+            private:
+                std::ifstream stream_;
+                std::vector<ValueType> block_;
+                std::size_t pos_;
+                std::size_t size_;
+        };
+
+        //Removes the spilled runs unless ownership was handed on
+        struct temp_files
+        {
+            temp_files() {}
+
+            temp_files(const temp_files &) = delete;
+            temp_files &operator=(const temp_files &) = delete;
+
+            ~temp_files()
+            {
+                for(const std::string &i : paths)
+                {
+                    std::remove(i.c_str());
+                }
+            }
+
+            std::vector<std::string> paths;
+        };
+
+        //The sorted runs of a single external_sort, which every traversal of its result reads from
+        template <typename ValueType>
+        struct external_runs
+        {
+            external_runs(std::vector<ValueType> &&run, const std::size_t &block) : memory_run(std::move(run)), block_size(block) {}
+
+            temp_files files;
+            std::vector<ValueType> memory_run;
+            std::size_t block_size;
+        };
+
+        //Merges the runs from the start, with its own readers, so traversals are independent of each other
+        template <typename ValueType>
+        class external_merge
+        {
+            public:
+                external_merge(const std::shared_ptr<const external_runs<ValueType>> &runs) : runs_(runs), memory_pos_(0), produced_(0)
+                {
+                    for(const std::string &i : runs_->files.paths)
+                    {
+                        readers_.push_back(std::unique_ptr<run_reader<ValueType>>(new run_reader<ValueType>(i, runs_->block_size)));
+                    }
+
+                    for(std::size_t i = 0; i < readers_.size(); ++i)
+                    {
+                        ValueType val;
+                        if(readers_[i]->next(val))
+                        {
+                            heap_.push(entry_type(val, i));
+                        }
+                    }
+                }
+
+                external_merge(const external_merge &) = delete;
+                external_merge &operator=(const external_merge &) = delete;
+
+                bool next(ValueType &val)
+                {
+                    if(readers_.empty())
+                    {
+                        if(memory_pos_ == runs_->memory_run.size())
+                        {
+                            return false;
+                        }
+
+                        val = runs_->memory_run[memory_pos_++];
+                        ++produced_;
+                        return true;
+                    }
+
+                    if(heap_.empty())
+                    {
+                        return false;
+                    }
+
+                    entry_type top = heap_.top();
+                    heap_.pop();
+                    val = top.first;
+
+                    ValueType refill;
+                    if(readers_[top.second]->next(refill))
+                    {
+                        heap_.push(entry_type(refill, top.second));
+                    }
+
+                    ++produced_;
+                    return true;
+                }
+
+                //The number of elements merged so far
+                std::size_t produced() const
+                {
+                    return produced_;
+                }
+
+                const std::shared_ptr<const external_runs<ValueType>> &runs() const
+                {
+                    return runs_;
+                }
+
+            private:
+                using entry_type = std::pair<ValueType, std::size_t>;
+
+                struct entry_greater
+                {
+                    bool operator()(const entry_type &a, const entry_type &b) const
+                    {
+                        return b.first < a.first;
+                    }
+                };
+
+                std::shared_ptr<const external_runs<ValueType>> runs_;
+                std::vector<std::unique_ptr<run_reader<ValueType>>> readers_;
+                std::priority_queue<entry_type, std::vector<entry_type>, entry_greater> heap_;
+                std::size_t memory_pos_;
+                std::size_t produced_;
+        };
+
+        //Streams the merged runs back in order. Each call to begin() starts a new merge, so the sequence
+        //can be traversed any number of times. Copies of an iterator share the merge until they diverge,
+        //after which the one left behind merges again from the start. Operations which need more than a
+        //forward traversal copy the elements into a std::vector, as with other views.
+        template <typename ValueType>
+        class external_sorted_sequence : public view_base
+        {
+            public:
+                using value_type = ValueType;
+
+                class const_iterator
+                {
+                    public:
+                        using iterator_category = std::input_iterator_tag;
+                        using value_type = ValueType;
+                        using difference_type = std::ptrdiff_t;
+                        using pointer = const ValueType *;
+                        using reference = const ValueType &;
+
+                        const_iterator() : consumed_(0) {}
+
+                        const_iterator(const std::shared_ptr<external_merge<ValueType>> &state) : state_(state), consumed_(0)
+                        {
+                            advance();
+                        }
+
+                        reference operator*() const
+                        {
+                            return current_;
+                        }
+
+                        pointer operator->() const
+                        {
+                            return &current_;
+                        }
+
+                        const_iterator &operator++()
+                        {
+                            advance();
+                            return *this;
+                        }
+
+                        const_iterator operator++(int)
+                        {
+                            const_iterator result(*this);
+                            advance();
+                            return result;
+                        }
+
+                        bool operator==(const const_iterator &other) const
+                        {
+                            return !state_ == !other.state_ && (!state_ || consumed_ == other.consumed_);
+                        }
+
+                        bool operator!=(const const_iterator &other) const
+                        {
+                            return !(*this == other);
+                        }
+
+                    private:
+                        void advance()
+                        {
+                            if(!state_)
+                            {
+                                return;
+                            }
+
+                            if(state_->produced() != consumed_)
+                            {
+                                state_ = std::make_shared<external_merge<ValueType>>(state_->runs());
+
+                                ValueType skipped;
+                                while(state_->produced() != consumed_)
+                                {
+                                    state_->next(skipped);
+                                }
+                            }
+
+                            if(state_->next(current_))
+                            {
+                                ++consumed_;
+                            }
+                            else
+                            {
+                                state_.reset();
+                            }
+                        }
+
+                        std::shared_ptr<external_merge<ValueType>> state_;
+                        std::size_t consumed_;
+                        ValueType current_;
+                };
+
+                using iterator = const_iterator;
+
+                external_sorted_sequence(const std::shared_ptr<const external_runs<ValueType>> &runs) : runs_(runs) {}
+
+                const_iterator begin() const
+                {
+                    return const_iterator(std::make_shared<external_merge<ValueType>>(runs_));
+                }
+
+                const_iterator end() const
+                {
+                    return const_iterator();
+                }
+
+            private:
+                std::shared_ptr<const external_runs<ValueType>> runs_;
+        };
+
+        struct external_sort_type
+        {
+            external_sort_type(const std::size_t &memory_budget, const std::string &temp_dir) : memory_budget_(memory_budget), temp_dir_(temp_dir) {}
+
+            template
+            <
+                typename SequenceType,
+                typename ValueType = typename SequenceType::value_type,
+                typename = typename std::enable_if<std::is_trivially_copyable<ValueType>::value>::type
+            >
+            external_sorted_sequence<ValueType> operator()(const SequenceType &sequence) const
+            {
+                using RunsType = external_runs<ValueType>;
+
+                //The radix sort of a run needs a scratch buffer as large as the run itself
+                const std::size_t buffers = std::is_same<typename sort_method<std::vector<ValueType>>::type, radix_sort_method>::value ? 2 : 1;
+                const std::size_t run_size = std::max<std::size_t>(1, memory_budget_ / sizeof(ValueType) / buffers);
+
+                temp_files files;
+                std::vector<ValueType> run;
+                run.reserve(run_size);
+
+                for(const ValueType &i : sequence)
+                {
+                    run.push_back(i);
+                    if(run.size() == run_size)
+                    {
+                        files.paths.push_back(spill(run));
+                    }
+                }
+
+                if(files.paths.empty())
+                {
+                    sort_type sort_obj;
+                    return external_sorted_sequence<ValueType>(std::make_shared<RunsType>(sort_obj(std::move(run)), 0));
+                }
+
+                if(!run.empty())
+                {
+                    files.paths.push_back(spill(run));
+                }
+
+                //Every run gets an equal share of the budget as its read buffer
+                const std::size_t block_size = std::max<std::size_t>(1, memory_budget_ / sizeof(ValueType) / files.paths.size());
+
+                std::shared_ptr<RunsType> runs = std::make_shared<RunsType>(std::vector<ValueType>(), block_size);
+                runs->files.paths.swap(files.paths);
+                return external_sorted_sequence<ValueType>(runs);
+            }
+
+            template <typename ValueType>
+            std::string spill(std::vector<ValueType> &run) const
+            {
+                sort_type sort_obj;
+                run = sort_obj(std::move(run));
+
+                std::string path;
+                std::FILE *file = create_run_file(path);
+                if(!file)
+                {
+                    throw std::runtime_error("Unable to create temporary file in " + temp_dir_);
+                }
+
+                const std::size_t written = std::fwrite(run.data(), sizeof(ValueType), run.size(), file);
+                if(std::fclose(file) != 0 || written != run.size())
+                {
+                    std::remove(path.c_str());
+                    throw std::runtime_error("Unable to write temporary file " + path);
+                }
+
+                run.clear();
+                return path;
+            }
+
+            //Creates a file with an unpredictable name which did not exist before, so that another user of
+            //temp_dir can neither have opened the file in advance nor redirect it to one of their own
+            std::FILE *create_run_file(std::string &path) const
+            {
+#if defined(__unix__) || defined(__APPLE__)
+                std::string pattern = temp_dir_ + "/stp_run_XXXXXX";
+                std::vector<char> name(pattern.begin(), pattern.end());
+                name.push_back('\0');
+
+                const int fd = mkstemp(name.data());
+                if(fd == -1)
+                {
+                    return nullptr;
+                }
+
+                path = name.data();
+
+                std::FILE *file = fdopen(fd, "wb");
+                if(!file)
+                {
+                    close(fd);
+                    std::remove(path.c_str());
+                }
+
+                return file;
+#else
+                static std::atomic<unsigned long> counter(0);
+                std::random_device device;
+
+                //Opening with "x" fails if the file exists, in which case another name is tried
+                for(int attempt = 0; attempt < 100; ++attempt)
+                {
+                    path = temp_dir_ + "/stp_run_" + std::to_string(device()) + "_" + std::to_string(device()) + "_" + std::to_string(counter++);
+
+                    std::FILE *file = std::fopen(path.c_str(), "wbx");
+                    if(file || errno != EEXIST)
+                    {
+                        return file;
+                    }
+                }
+
+                return nullptr;
+#endif
+            }
+
+            std::size_t memory_budget_;
+            std::string temp_dir_;
+        };
+    }
+
+    inline detail::external_sort_type external_sort(const std::size_t &memory_budget, const std::string &temp_dir)
+    {
+        return detail::external_sort_type(memory_budget, temp_dir);
+    }
+}
+
+#endif
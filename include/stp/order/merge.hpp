@@ -0,0 +1,270 @@
+#ifndef STP_MERGE_HPP
+#define STP_MERGE_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "../parallel.hpp"
+
+namespace stp
+{
+    namespace detail
+    {
+        const std::size_t parallel_merge_grain = 1 << 14;
+
+        template
+        <
+            typename InIterType1,
+            typename InIterType2,
+            typename OutIterType,
+            typename Compare
+        >
+        OutIterType move_merge(InIterType1 first1, InIterType1 last1, InIterType2 first2, InIterType2 last2, OutIterType out, const Compare &cmp)
+        {
+            while(first1 != last1 && first2 != last2)
+            {
+                if(cmp(*first2, *first1))
+                {
+                    *out = std::move(*first2);
+                    ++first2;
+                }
+                else
+                {
+                    *out = std::move(*first1);
+                    ++first1;
+                }
+
+                ++out;
+            }
+
+            return std::move(first2, last2, std::move(first1, last1, out));
+        }
+
+        //Merges the adjacent sorted ranges [first, mid) and [mid, last) in place. Elements already in their final
+        //position at either end are skipped, and only the smaller of the remaining halves is moved into buffer.
+        template
+        <
+            typename IterType,
+            typename Compare,
+            typename ValueType = typename std::iterator_traits<IterType>::value_type
+        >
+        void merge_adjacent(IterType first, IterType mid, IterType last, const Compare &cmp, std::vector<ValueType> &buffer)
+        {
+            first = std::upper_bound(first, mid, *mid, cmp);
+            if(first == mid)
+            {
+                return;
+            }
+
+            last = std::lower_bound(mid, last, *(mid - 1), cmp);
+
+            buffer.clear();
+            if(mid - first <= last - mid)
+            {
+                std::move(first, mid, std::back_inserter(buffer));
+                move_merge(buffer.begin(), buffer.end(), mid, last, first, cmp);
+            }
+            else
+            {
+                std::move(mid, last, std::back_inserter(buffer));
+
+                IterType left = mid;
+                typename std::vector<ValueType>::iterator right = buffer.end();
+                IterType out = last;
+
+                while(left != first && right != buffer.begin())
+                {
+                    if(cmp(*(right - 1), *(left - 1)))
+                    {
+                        *--out = std::move(*--left);
+                    }
+                    else
+                    {
+                        *--out = std::move(*--right);
+                    }
+                }
+
+                std::move_backward(buffer.begin(), right, out);
+            }
+        }
+
+        //Merges the sorted runs [first + bounds[i], first + bounds[i + 1]) into one, pairwise and in place
+        template
+        <
+            typename IterType,
+            typename Compare
+        >
+        void merge_runs_in_place(IterType first, std::vector<std::size_t> bounds, const Compare &cmp)
+        {
+            using ValueType = typename std::iterator_traits<IterType>::value_type;
+
+            std::vector<ValueType> buffer;
+
+            while(bounds.size() > 2)
+            {
+                const std::size_t runs = bounds.size() - 1;
+
+                std::vector<std::size_t> merged;
+                for(std::size_t i = 0; i + 1 < runs; i += 2)
+                {
+                    merge_adjacent(first + bounds[i], first + bounds[i + 1], first + bounds[i + 2], cmp, buffer);
+                    merged.push_back(bounds[i]);
+                }
+
+                if(runs % 2 == 1)
+                {
+                    merged.push_back(bounds[runs - 1]);
+                }
+
+                merged.push_back(bounds.back());
+                bounds.swap(merged);
+            }
+        }
+
+        //Splits the larger range in half and the other at its bound, merging both halves concurrently
+        template
+        <
+            typename InIterType,
+            typename OutIterType,
+            typename Compare
+        >
+        void parallel_merge(InIterType first1, InIterType last1, InIterType first2, InIterType last2, OutIterType out, const Compare &cmp, const std::size_t &workers)
+        {
+            const std::size_t n1 = last1 - first1;
+            const std::size_t n2 = last2 - first2;
+
+            if(workers < 2 || n1 + n2 < parallel_merge_grain)
+            {
+                move_merge(first1, last1, first2, last2, out, cmp);
+                return;
+            }
+
+            InIterType mid1 = first1;
+            InIterType mid2 = first2;
+
+            if(n1 >= n2)
+            {
+                mid1 = first1 + n1 / 2;
+                mid2 = std::lower_bound(first2, last2, *mid1, cmp);
+            }
+            else
+            {
+                mid2 = first2 + n2 / 2;
+                mid1 = std::upper_bound(first1, last1, *mid2, cmp);
+            }
+
+            const OutIterType out_mid = out + (mid1 - first1) + (mid2 - first2);
+
+            parallel_for(2, [&](const std::size_t &i)
+            {
+                if(i == 0)
+                {
+                    parallel_merge(first1, mid1, first2, mid2, out, cmp, workers / 2);
+                }
+                else
+                {
+                    parallel_merge(mid1, last1, mid2, last2, out_mid, cmp, workers - workers / 2);
+                }
+            });
+        }
+
+        //Merges neighbouring pairs of sorted runs from src into dst, halving the number of runs
+        template
+        <
+            typename InIterType,
+            typename OutIterType,
+            typename Compare
+        >
+        void merge_runs(InIterType src, OutIterType dst, std::vector<std::size_t> &bounds, const Compare &cmp, const std::size_t &workers)
+        {
+            const std::size_t runs = bounds.size() - 1;
+            const std::size_t pairs = (runs + 1) / 2;
+            const std::size_t pair_workers = std::max<std::size_t>(1, workers / pairs);
+
+            auto merge_pair = [&](const std::size_t &i)
+            {
+                const std::size_t lo = bounds[2 * i];
+                const std::size_t mid = bounds[2 * i + 1];
+
+                if(2 * i + 1 == runs)
+                {
+                    std::move(src + lo, src + mid, dst + lo);
+                }
+                else
+                {
+                    const std::size_t hi = bounds[2 * i + 2];
+                    parallel_merge(src + lo, src + mid, src + mid, src + hi, dst + lo, cmp, pair_workers);
+                }
+            };
+
+            if(workers < 2)
+            {
+                for(std::size_t i = 0; i < pairs; ++i)
+                {
+                    merge_pair(i);
+                }
+            }
+            else
+            {
+                parallel_for(pairs, merge_pair);
+            }
+
+            std::vector<std::size_t> merged;
+            for(std::size_t i = 0; i < bounds.size(); i += 2)
+            {
+                merged.push_back(bounds[i]);
+            }
+
+            if(merged.back() != bounds.back())
+            {
+                merged.push_back(bounds.back());
+            }
+
+            bounds.swap(merged);
+        }
+
+        //Merges the sorted runs [first + bounds[i], first + bounds[i + 1]) into one, alternating between the range and a buffer
+        template
+        <
+            typename IterType,
+            typename Compare
+        >
+        void merge_sorted_runs(IterType first, std::vector<std::size_t> bounds, const Compare &cmp, const std::size_t &workers)
+        {
+            using ValueType = typename std::iterator_traits<IterType>::value_type;
+
+            if(bounds.size() <= 2)
+            {
+                return;
+            }
+
+            const IterType last = first + bounds.back();
+            std::vector<ValueType> buffer(std::make_move_iterator(first), std::make_move_iterator(last));
+            bool in_buffer = true;
+
+            while(bounds.size() > 2)
+            {
+                if(in_buffer)
+                {
+                    merge_runs(buffer.begin(), first, bounds, cmp, workers);
+                }
+                else
+                {
+                    merge_runs(first, buffer.begin(), bounds, cmp, workers);
+                }
+
+                in_buffer = !in_buffer;
+            }
+
+            if(in_buffer)
+            {
+                std::move(buffer.begin(), buffer.end(), first);
+            }
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,128 @@
+#ifndef STP_PARALLEL_SORT_HPP
+#define STP_PARALLEL_SORT_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "merge.hpp"
+#include "sort.hpp"
+#include "../parallel.hpp"
+#include "../tags.hpp"
+#include "../traits.hpp"
+
+namespace stp
+{
+    namespace detail
+    {
+        const std::size_t parallel_sort_threshold = 1 << 15;
+
+        //Sorts equal slices on separate threads, then merges them pairwise
+        template
+        <
+            typename IterType,
+            typename Compare,
+            typename ChunkSorter
+        >
+        void parallel_sort(IterType first, IterType last, const Compare &cmp, const ChunkSorter &sorter, const std::size_t &workers)
+        {
+            const std::size_t n = last - first;
+
+            if(n < parallel_sort_threshold || workers < 2)
+            {
+                sorter(first, last);
+                return;
+            }
+
+            const std::size_t chunks = std::min(workers, n / (parallel_sort_threshold / 2));
+
+            std::vector<std::size_t> bounds;
+            for(std::size_t i = 0; i <= chunks; ++i)
+            {
+                bounds.push_back(n * i / chunks);
+            }
+
+            parallel_for(chunks, [&](const std::size_t &i)
+            {
+                sorter(first + bounds[i], first + bounds[i + 1]);
+            });
+
+            merge_sorted_runs(first, bounds, cmp, workers);
+        }
+
+        struct par_sort_type
+        {
+            template
+            <
+                typename SequenceType,
+                typename ValueType = typename SequenceType::value_type,
+                typename = typename std::enable_if<!is_view<SequenceType>::value>::type
+            >
+            SequenceType operator()(SequenceType sequence) const
+            {
+                using MethodType = typename sort_method<SequenceType>::type;
+
+                parallel_sort(std::begin(sequence), std::end(sequence), less_compare(), method_sorter<MethodType>(), parallel_workers());
+                return sequence;
+            }
+
+            template
+            <
+                typename SequenceType,
+                typename = typename std::enable_if<is_view<SequenceType>::value>::type
+            >
+            owned_type<SequenceType> operator()(const SequenceType &sequence) const
+            {
+                return (*this)(materialize(sequence));
+            }
+        };
+
+        template <typename Predicate>
+        struct par_sort_with_type
+        {
+            constexpr par_sort_with_type(const Predicate &pred) : pred_(pred) {}
+
+            template
+            <
+                typename SequenceType,
+                typename ValueType = typename SequenceType::value_type,
+                typename PredType = typename std::result_of<Predicate(ValueType, ValueType)>::type,
+                typename = typename std::enable_if<std::is_convertible<PredType, bool>::value>::type,
+                typename = typename std::enable_if<!is_view<SequenceType>::value>::type
+            >
+            SequenceType operator()(SequenceType sequence) const
+            {
+                parallel_sort(std::begin(sequence), std::end(sequence), pred_, compare_sorter<Predicate>(pred_), parallel_workers());
+                return sequence;
+            }
+
+            template
+            <
+                typename SequenceType,
+                typename = typename std::enable_if<is_view<SequenceType>::value>::type
+            >
+            owned_type<SequenceType> operator()(const SequenceType &sequence) const
+            {
+                return (*this)(materialize(sequence));
+            }
+
+            Predicate pred_;
+        };
+    }
+
+    constexpr detail::par_sort_type sort(detail::par_tag)
+    {
+        return detail::par_sort_type();
+    }
+
+    template <typename Predicate>
+    constexpr detail::par_sort_with_type<Predicate> sort_with(detail::par_tag, const Predicate &pred)
+    {
+        return detail::par_sort_with_type<Predicate>(pred);
+    }
+}
+
+#endif
@@ -0,0 +1,140 @@
+#ifndef STP_RADIX_HPP
+#define STP_RADIX_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+namespace stp
+{
+    namespace detail
+    {
+        //Maps each sortable value to an unsigned integer with the same ordering
+        template
+        <
+            typename ValueType,
+            typename Enable = void
+        >
+        struct radix_key
+        {
+            static const bool value = false;
+        };
+
+        template <typename ValueType>
+        struct radix_key<ValueType, typename std::enable_if<std::is_integral<ValueType>::value && !std::is_same<ValueType, bool>::value>::type>
+        {
+            static const bool value = true;
+
+            using key_type = typename std::make_unsigned<ValueType>::type;
+
+            static key_type get(const ValueType &val)
+            {
+                const key_type sign = std::is_signed<ValueType>::value ? static_cast<key_type>(key_type(1) << (sizeof(key_type) * 8 - 1)) : key_type(0);
+                return static_cast<key_type>(static_cast<key_type>(val) ^ sign);
+            }
+        };
+
+        template <typename ValueType>
+        struct radix_key<ValueType, typename std::enable_if<std::is_floating_point<ValueType>::value && std::numeric_limits<ValueType>::is_iec559 && (sizeof(ValueType) == 4 || sizeof(ValueType) == 8)>::type>
+        {
+            static const bool value = true;
+
+            using key_type = typename std::conditional<sizeof(ValueType) == 4, std::uint32_t, std::uint64_t>::type;
+
+            //Negative numbers have every bit flipped so larger magnitudes sort first,
+            //positive numbers only have the sign bit flipped
+            static key_type get(const ValueType &val)
+            {
+                key_type bits;
+                std::memcpy(&bits, &val, sizeof(bits));
+
+                const key_type sign = static_cast<key_type>(key_type(1) << (sizeof(key_type) * 8 - 1));
+                return (bits & sign) ? static_cast<key_type>(~bits) : static_cast<key_type>(bits ^ sign);
+            }
+        };
+
+        //Below this size std::sort beats the fixed cost of the histogram passes
+        const std::size_t radix_sort_threshold = 2048;
+
+        //Stable least-significant-digit radix sort on 8 bit digits. Digits for
+        //which every element falls into the same bucket are skipped.
+        template
+        <
+            typename ValueType,
+            typename KeyFunction
+        >
+        void radix_sort(ValueType *first, ValueType *last, KeyFunction key)
+        {
+            using KeyType = decltype(key(*first));
+            const std::size_t digits = sizeof(KeyType);
+            const std::size_t n = static_cast<std::size_t>(last - first);
+
+            if(n < 2)
+            {
+                return;
+            }
+
+            std::vector<std::array<std::size_t, 256>> counts(digits);
+            for(std::array<std::size_t, 256> &i : counts)
+            {
+                i.fill(0);
+            }
+
+            for(ValueType *i = first; i != last; ++i)
+            {
+                KeyType k = key(*i);
+                for(std::size_t d = 0; d < digits; ++d)
+                {
+                    ++counts[d][(k >> (d * 8)) & 0xff];
+                }
+            }
+
+            std::vector<ValueType> buffer(first, last);
+            ValueType *src = first;
+            ValueType *dst = buffer.data();
+
+            for(std::size_t d = 0; d < digits; ++d)
+            {
+                std::array<std::size_t, 256> &count = counts[d];
+                if(count[(key(*src) >> (d * 8)) & 0xff] == n)
+                {
+                    continue;
+                }
+
+                std::size_t offset = 0;
+                for(std::size_t &i : count)
+                {
+                    std::size_t c = i;
+                    i = offset;
+                    offset += c;
+                }
+
+                for(ValueType *i = src; i != src + n; ++i)
+                {
+                    dst[count[(key(*i) >> (d * 8)) & 0xff]++] = std::move(*i);
+                }
+
+                std::swap(src, dst);
+            }
+
+            if(src != first)
+            {
+                std::move(src, src + n, first);
+            }
+        }
+
+        template <typename ValueType>
+        void radix_sort(ValueType *first, ValueType *last)
+        {
+            radix_sort(first, last, [](const ValueType &i){return radix_key<ValueType>::get(i);});
+        }
+    }
+}
+
+#endif
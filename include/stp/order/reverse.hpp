@@ -1,28 +1,110 @@
 #ifndef STP_REVERSE_HPP
 #define STP_REVERSE_HPP
 
-#include <algorithm>
+#include <cstddef>
 #include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../traits.hpp"
 
 namespace stp
 {
     namespace detail
     {
+        //Refers to an lvalue sequence, or takes ownership of an rvalue sequence, and traverses it backwards
+        template <typename SequenceType>
+        class reverse_view : public view_base
+        {
+            private:
+                using container_type = typename std::decay<SequenceType>::type;
+
+            public:
+                using value_type = typename container_type::value_type;
+                using const_iterator = std::reverse_iterator<typename container_type::const_iterator>;
+                using iterator = const_iterator;
+                using difference_type = typename std::iterator_traits<const_iterator>::difference_type;
+                using size_type = std::size_t;
+
+                reverse_view(SequenceType &&sequence) : sequence_(std::forward<SequenceType>(sequence)) {}
+
+                const_iterator begin() const
+                {
+                    return const_iterator(std::end(static_cast<const container_type &>(sequence_)));
+                }
+
+                const_iterator end() const
+                {
+                    return const_iterator(std::begin(static_cast<const container_type &>(sequence_)));
+                }
+
+                size_type size() const
+                {
+                    return static_cast<size_type>(std::distance(begin(), end()));
+                }
+
+                bool empty() const
+                {
+                    return begin() == end();
+                }
+
+                operator tail_type<container_type>() const
+                {
+                    return tail_type<container_type>(begin(), end());
+                }
+
+            private:
+                SequenceType sequence_;
+        };
+
+        //Operations on a reversed sequence build the type of that sequence when it can be built from iterators
+        template <typename SequenceType>
+        struct owned<reverse_view<SequenceType>, true>
+        {
+            private:
+                using container_type = owned_type<typename std::decay<SequenceType>::type>;
+                using iterator = typename reverse_view<SequenceType>::const_iterator;
+
+            public:
+                using type = typename std::conditional<std::is_constructible<container_type, iterator, iterator>::value,
+                                                       container_type,
+                                                       std::vector<typename reverse_view<SequenceType>::value_type>>::type;
+        };
+
+        template <typename SequenceType>
+        struct is_bidirectional : std::is_base_of<std::bidirectional_iterator_tag, typename std::iterator_traits<decltype(std::begin(std::declval<const typename std::decay<SequenceType>::type &>()))>::iterator_category> {};
+
         struct reverse_type
         {
-            template <typename SequenceType>
-            SequenceType operator()(SequenceType sequence) const
+            template
+            <
+                typename SequenceType,
+                typename = typename std::enable_if<is_bidirectional<SequenceType>::value>::type
+            >
+            reverse_view<SequenceType> operator()(SequenceType &&sequence) const
+            {
+                return reverse_view<SequenceType>(std::forward<SequenceType>(sequence));
+            }
+
+            //Views which can only be traversed forwards are copied first
+            template
+            <
+                typename SequenceType,
+                typename = typename std::enable_if<!is_bidirectional<SequenceType>::value && is_view<SequenceType>::value>::type,
+                typename = void
+            >
+            reverse_view<owned_type<typename std::decay<SequenceType>::type>> operator()(const SequenceType &sequence) const
             {
-                std::reverse(std::begin(sequence), std::end(sequence));
-                return sequence;
+                return reverse_view<owned_type<typename std::decay<SequenceType>::type>>(materialize(sequence));
             }
         };
     }
 
-    detail::reverse_type reverse()
+    constexpr detail::reverse_type reverse()
     {
         return detail::reverse_type();
     }
 }
 
-#endif
\ No newline at end of file
+#endif
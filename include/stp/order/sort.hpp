@@ -2,55 +2,399 @@
 #define STP_SORT_HPP
 
 #include <algorithm>
+#include <cstddef>
 #include <iterator>
+#include <string>
 #include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "merge.hpp"
+#include "radix.hpp"
+#include "string_sort.hpp"
+#include "../traits.hpp"
 
 namespace stp
 {
     namespace detail
     {
+        struct comparison_sort_method {};
+        struct radix_sort_method {};
+        struct string_sort_method {};
+
+        template
+        <
+            typename SequenceType,
+            typename ValueType = typename SequenceType::value_type
+        >
+        struct sort_method
+        {
+            using type = typename std::conditional
+            <
+                is_contiguous<SequenceType>::value && radix_key<ValueType>::value,
+                radix_sort_method,
+                typename std::conditional
+                <
+                    is_contiguous<SequenceType>::value && std::is_same<ValueType, std::string>::value,
+                    string_sort_method,
+                    comparison_sort_method
+                >::type
+            >::type;
+        };
+
+        template <typename IterType>
+        void sort_range(IterType first, IterType last, comparison_sort_method)
+        {
+            std::sort(first, last);
+        }
+
+        template <typename IterType>
+        void sort_range(IterType first, IterType last, radix_sort_method)
+        {
+            if(static_cast<std::size_t>(last - first) >= radix_sort_threshold)
+            {
+                radix_sort(&*first, &*first + (last - first));
+            }
+            else
+            {
+                std::sort(first, last);
+            }
+        }
+
+        template <typename IterType>
+        void sort_range(IterType first, IterType last, string_sort_method)
+        {
+            if(static_cast<std::size_t>(last - first) >= string_sort_threshold)
+            {
+                string_sort(&*first, &*first + (last - first));
+            }
+            else
+            {
+                std::sort(first, last);
+            }
+        }
+
+        template <typename Compare>
+        struct compare_sorter
+        {
+            constexpr compare_sorter(const Compare &cmp) : cmp_(cmp) {}
+
+            template <typename IterType>
+            void operator()(IterType first, IterType last) const
+            {
+                std::sort(first, last, cmp_);
+            }
+
+            Compare cmp_;
+        };
+
+        template <typename Method>
+        struct method_sorter
+        {
+            template <typename IterType>
+            void operator()(IterType first, IterType last) const
+            {
+                sort_range(first, last, Method());
+            }
+        };
+
+        //Presorted input is only exploited when its natural runs average at least this many elements
+        const std::size_t adaptive_run_length = 32;
+
+        //Up to this many runs are merged directly, above it the input is treated as sorted with outliers
+        const std::size_t adaptive_merge_runs = 64;
+
+        //Splits the range into non-descending runs, reversing descending runs in place. Gives up as soon
+        //as the runs are too short on average for merging them to beat sorting.
+        template
+        <
+            typename IterType,
+            typename Compare
+        >
+        bool find_runs(IterType first, IterType last, const Compare &cmp, std::vector<std::size_t> &bounds)
+        {
+            const std::size_t n = last - first;
+            const std::size_t max_runs = n / adaptive_run_length;
+
+            if(max_runs == 0)
+            {
+                return false;
+            }
+
+            bounds.assign(1, 0);
+
+            std::size_t i = 0;
+            while(i < n)
+            {
+                std::size_t j = i + 1;
+
+                if(j < n && cmp(first[j], first[i]))
+                {
+                    ++j;
+                    while(j < n && !cmp(first[j - 1], first[j]))
+                    {
+                        ++j;
+                    }
+
+                    std::reverse(first + i, first + j);
+                }
+                else
+                {
+                    while(j < n && !cmp(first[j], first[j - 1]))
+                    {
+                        ++j;
+                    }
+                }
+
+                bounds.push_back(j);
+                if(bounds.size() - 1 > max_runs)
+                {
+                    return false;
+                }
+
+                i = j;
+            }
+
+            return true;
+        }
+
+        //Moves every element which breaks the ascending order to a separate buffer, along with the element it
+        //broke the order against, so the remaining prefix is sorted. Only the outliers are then sorted, and
+        //merged back into the prefix. Gives up, restoring the range as a permutation of the input, once more
+        //than a quarter of the elements are outliers.
+        template
+        <
+            typename IterType,
+            typename Compare,
+            typename Sorter
+        >
+        bool sort_outliers(IterType first, IterType last, const Compare &cmp, const Sorter &sorter)
+        {
+            using ValueType = typename std::iterator_traits<IterType>::value_type;
+
+            const std::size_t n = last - first;
+            const std::size_t max_outliers = n / 4;
+
+            std::vector<ValueType> outliers;
+            std::size_t kept = 0;
+
+            for(std::size_t i = 0; i < n; ++i)
+            {
+                if(kept == 0 || !cmp(first[i], first[kept - 1]))
+                {
+                    if(kept != i)
+                    {
+                        first[kept] = std::move(first[i]);
+                    }
+
+                    ++kept;
+                }
+                else
+                {
+                    outliers.push_back(std::move(first[i]));
+                    outliers.push_back(std::move(first[--kept]));
+                }
+
+                if(outliers.size() > max_outliers)
+                {
+                    std::move(outliers.begin(), outliers.end(), first + kept);
+                    return false;
+                }
+            }
+
+            sorter(outliers.begin(), outliers.end());
+
+            IterType left = first + kept;
+            typename std::vector<ValueType>::iterator right = outliers.end();
+            IterType out = last;
+
+            while(left != first && right != outliers.begin())
+            {
+                if(cmp(*(right - 1), *(left - 1)))
+                {
+                    *--out = std::move(*--left);
+                }
+                else
+                {
+                    *--out = std::move(*--right);
+                }
+            }
+
+            std::move_backward(outliers.begin(), right, out);
+            return true;
+        }
+
+        template
+        <
+            typename IterType,
+            typename Compare,
+            typename Sorter
+        >
+        void adaptive_sort(IterType first, IterType last, const Compare &cmp, const Sorter &sorter)
+        {
+            std::vector<std::size_t> bounds;
+
+            if(!find_runs(first, last, cmp, bounds))
+            {
+                sorter(first, last);
+            }
+            else if(bounds.size() - 1 <= adaptive_merge_runs)
+            {
+                merge_runs_in_place(first, bounds, cmp);
+            }
+            else if(!sort_outliers(first, last, cmp, sorter))
+            {
+                sorter(first, last);
+            }
+        }
+
         struct sort_type
         {
-            template <typename SequenceType>
+            template
+            <
+                typename SequenceType,
+                typename ValueType = typename SequenceType::value_type,
+                typename = typename std::enable_if<!is_view<SequenceType>::value>::type
+            >
             SequenceType operator()(SequenceType sequence) const
             {
-                std::sort(std::begin(sequence), std::end(sequence));
+                using MethodType = typename sort_method<SequenceType>::type;
+
+                adaptive_sort(std::begin(sequence), std::end(sequence), less_compare(), method_sorter<MethodType>());
                 return sequence;
             }
+
+            template
+            <
+                typename SequenceType,
+                typename = typename std::enable_if<is_view<SequenceType>::value>::type
+            >
+            owned_type<SequenceType> operator()(const SequenceType &sequence) const
+            {
+                return (*this)(materialize(sequence));
+            }
         };
 
         template <typename Predicate>
         struct sort_with_type
         {
-            sort_with_type(const Predicate &pred) : pred_(pred) {}
+            constexpr sort_with_type(const Predicate &pred) : pred_(pred) {}
 
             template
             <
                 typename SequenceType,
                 typename ValueType = typename SequenceType::value_type,
                 typename PredType = typename std::result_of<Predicate(ValueType, ValueType)>::type,
-                typename = typename std::enable_if<std::is_convertible<PredType, bool>::value>::type
+                typename = typename std::enable_if<std::is_convertible<PredType, bool>::value>::type,
+                typename = typename std::enable_if<!is_view<SequenceType>::value>::type
             >
             SequenceType operator()(SequenceType sequence) const
             {
-                std::sort(std::begin(sequence), std::end(sequence), pred_);
+                adaptive_sort(std::begin(sequence), std::end(sequence), pred_, compare_sorter<Predicate>(pred_));
                 return sequence;
             }
 
+            template
+            <
+                typename SequenceType,
+                typename = typename std::enable_if<is_view<SequenceType>::value>::type
+            >
+            owned_type<SequenceType> operator()(const SequenceType &sequence) const
+            {
+                return (*this)(materialize(sequence));
+            }
+
             Predicate pred_;
         };
+
+        template <typename KeyFunction>
+        struct sort_by_type
+        {
+            constexpr sort_by_type(const KeyFunction &key) : key_(key) {}
+
+            template
+            <
+                typename SequenceType,
+                typename ValueType = typename SequenceType::value_type,
+                typename KeyType = typename std::decay<typename std::result_of<KeyFunction(ValueType)>::type>::type,
+                typename = typename std::enable_if<!is_view<SequenceType>::value>::type
+            >
+            SequenceType operator()(SequenceType sequence) const
+            {
+                using PairType = std::pair<KeyType, std::size_t>;
+
+                //Each key is computed exactly once, then only the keys are sorted
+                std::vector<PairType> keyed;
+                std::size_t index = 0;
+                for(const ValueType &i : sequence)
+                {
+                    keyed.push_back(PairType(key_(i), index++));
+                }
+
+                sort_keys(keyed, std::integral_constant<bool, radix_key<KeyType>::value>());
+
+                std::vector<ValueType> values(std::make_move_iterator(std::begin(sequence)), std::make_move_iterator(std::end(sequence)));
+
+                auto out = std::begin(sequence);
+                for(const PairType &i : keyed)
+                {
+                    *out = std::move(values[i.second]);
+                    ++out;
+                }
+
+                return sequence;
+            }
+
+            template
+            <
+                typename SequenceType,
+                typename = typename std::enable_if<is_view<SequenceType>::value>::type
+            >
+            owned_type<SequenceType> operator()(const SequenceType &sequence) const
+            {
+                return (*this)(materialize(sequence));
+            }
+
+            //Like sort(), short inputs are not worth the radix sort's scratch buffer and passes
+            template <typename PairType>
+            void sort_keys(std::vector<PairType> &keyed, std::true_type) const
+            {
+                if(keyed.size() < radix_sort_threshold)
+                {
+                    sort_keys(keyed, std::false_type());
+                    return;
+                }
+
+                using KeyType = typename PairType::first_type;
+                radix_sort(keyed.data(), keyed.data() + keyed.size(), [](const PairType &i){return radix_key<KeyType>::get(i.first);});
+            }
+
+            template <typename PairType>
+            void sort_keys(std::vector<PairType> &keyed, std::false_type) const
+            {
+                std::stable_sort(std::begin(keyed), std::end(keyed), [](const PairType &a, const PairType &b){return a.first < b.first;});
+            }
+
+            KeyFunction key_;
+        };
     }
 
-    detail::sort_type sort()
+    constexpr detail::sort_type sort()
     {
         return detail::sort_type();
     }
 
     template <typename Predicate>
-    detail::sort_with_type<Predicate> sort_with(const Predicate &pred)
+    constexpr detail::sort_with_type<Predicate> sort_with(const Predicate &pred)
     {
         return detail::sort_with_type<Predicate>(pred);
     }
+
+    template <typename KeyFunction>
+    constexpr detail::sort_by_type<detail::projected_type<KeyFunction>> sort_by(const KeyFunction &key)
+    {
+        return detail::sort_by_type<detail::projected_type<KeyFunction>>(key);
+    }
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,127 @@
+#ifndef STP_STRING_SORT_HPP
+#define STP_STRING_SORT_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "radix.hpp"
+
+namespace stp
+{
+    namespace detail
+    {
+        //Below this size std::sort beats building and sorting the prefix keys
+        const std::size_t string_sort_threshold = 256;
+        const std::size_t string_prefix_bytes = 8;
+
+        struct string_entry
+        {
+            std::uint64_t prefix;
+            std::size_t index;
+        };
+
+        //Packs the bytes at [depth, depth + 8) big-endian into an integer, padding with zeros past the end,
+        //so comparing prefixes as integers orders the strings like std::string::compare does
+        inline std::uint64_t string_prefix(const std::string &str, const std::size_t &depth)
+        {
+            std::uint64_t prefix = 0;
+            for(std::size_t i = 0; i < string_prefix_bytes; ++i)
+            {
+                prefix <<= 8;
+                if(depth + i < str.size())
+                {
+                    prefix |= static_cast<unsigned char>(str[depth + i]);
+                }
+            }
+
+            return prefix;
+        }
+
+        //Multikey sort: orders entries by the next 8 bytes, then recurses into each run of equal prefixes.
+        //Within a run, strings which end inside the prefix come first, shortest first, since zero padding
+        //cannot tell "ab" from "ab\0".
+        inline void string_sort_entries(const std::string *strings, string_entry *first, string_entry *last, const std::size_t &depth)
+        {
+            const std::size_t n = static_cast<std::size_t>(last - first);
+
+            if(n < 2)
+            {
+                return;
+            }
+
+            if(n < 32)
+            {
+                std::sort(first, last, [strings, depth](const string_entry &a, const string_entry &b)
+                {
+                    return strings[a.index].compare(depth, std::string::npos, strings[b.index], depth, std::string::npos) < 0;
+                });
+                return;
+            }
+
+            for(string_entry *i = first; i != last; ++i)
+            {
+                i->prefix = string_prefix(strings[i->index], depth);
+            }
+
+            if(n >= radix_sort_threshold)
+            {
+                radix_sort(first, last, [](const string_entry &i){return i.prefix;});
+            }
+            else
+            {
+                std::sort(first, last, [](const string_entry &a, const string_entry &b){return a.prefix < b.prefix;});
+            }
+
+            const std::size_t next_depth = depth + string_prefix_bytes;
+
+            string_entry *run = first;
+            while(run != last)
+            {
+                string_entry *run_end = run + 1;
+                while(run_end != last && run_end->prefix == run->prefix)
+                {
+                    ++run_end;
+                }
+
+                if(run_end - run > 1)
+                {
+                    string_entry *longer = std::partition(run, run_end, [strings, next_depth](const string_entry &i){return strings[i.index].size() <= next_depth;});
+
+                    std::sort(run, longer, [strings](const string_entry &a, const string_entry &b){return strings[a.index].size() < strings[b.index].size();});
+                    string_sort_entries(strings, longer, run_end, next_depth);
+                }
+
+                run = run_end;
+            }
+        }
+
+        //Sorts the strings through an index of cached prefixes, moving each string only once at the end
+        inline void string_sort(std::string *first, std::string *last)
+        {
+            const std::size_t n = static_cast<std::size_t>(last - first);
+
+            std::vector<string_entry> entries(n);
+            for(std::size_t i = 0; i < n; ++i)
+            {
+                entries[i].index = i;
+            }
+
+            string_sort_entries(first, entries.data(), entries.data() + n, 0);
+
+            std::vector<std::string> sorted;
+            sorted.reserve(n);
+            for(const string_entry &i : entries)
+            {
+                sorted.push_back(std::move(first[i.index]));
+            }
+
+            std::move(sorted.begin(), sorted.end(), first);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,330 @@
+#ifndef STP_TOP_K_HPP
+#define STP_TOP_K_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../accumulator.hpp"
+#include "../traits.hpp"
+
+namespace stp
+{
+    namespace detail
+    {
+        template <typename Compare>
+        struct flip_compare
+        {
+            constexpr flip_compare(const Compare &cmp) : cmp_(cmp) {}
+
+            template <typename ValueType>
+            bool operator()(const ValueType &a, const ValueType &b) const
+            {
+                return cmp_(b, a);
+            }
+
+            Compare cmp_;
+        };
+
+        template <typename Compare>
+        struct first_compare
+        {
+            constexpr first_compare(const Compare &cmp) : cmp_(cmp) {}
+
+            template <typename PairType>
+            bool operator()(const PairType &a, const PairType &b) const
+            {
+                return cmp_(a.first, b.first);
+            }
+
+            Compare cmp_;
+        };
+
+        //Keeps the k largest elements seen so far, with the smallest of them
+        //at the front so it can be evicted in O(log k)
+        template
+        <
+            typename ValueType,
+            typename Compare
+        >
+        class bounded_heap
+        {
+            public:
+                bounded_heap(const std::size_t &k, const Compare &cmp) : k_(k), greater_(cmp) {}
+
+                void push(const ValueType &val)
+                {
+                    if(k_ == 0)
+                    {
+                        return;
+                    }
+
+                    if(heap_.size() < k_)
+                    {
+                        heap_.push_back(val);
+                        std::push_heap(std::begin(heap_), std::end(heap_), greater_);
+                    }
+                    else if(greater_(val, heap_.front()))
+                    {
+                        std::pop_heap(std::begin(heap_), std::end(heap_), greater_);
+                        heap_.back() = val;
+                        std::push_heap(std::begin(heap_), std::end(heap_), greater_);
+                    }
+                }
+
+                void merge(const bounded_heap &other)
+                {
+                    for(const ValueType &i : other.heap_)
+                    {
+                        push(i);
+                    }
+                }
+
+                std::vector<ValueType> sorted() const
+                {
+                    std::vector<ValueType> result(heap_);
+                    std::sort_heap(std::begin(result), std::end(result), greater_);
+                    return result;
+                }
+
+            private:
+                std::size_t k_;
+                flip_compare<Compare> greater_;
+                std::vector<ValueType> heap_;
+        };
+
+        template <typename Compare>
+        struct top_k_type
+        {
+            constexpr top_k_type(const std::size_t &k, const Compare &cmp) : k_(k), cmp_(cmp) {}
+
+            template
+            <
+                typename SequenceType,
+                typename ValueType = typename SequenceType::value_type,
+                typename PredType = typename std::result_of<Compare(ValueType, ValueType)>::type,
+                typename = typename std::enable_if<std::is_convertible<PredType, bool>::value>::type
+            >
+            std::vector<ValueType> operator()(const SequenceType &sequence) const
+            {
+                bounded_heap<ValueType, Compare> heap(k_, cmp_);
+                for(const ValueType &i : sequence)
+                {
+                    heap.push(i);
+                }
+                return heap.sorted();
+            }
+
+            template <typename ValueType>
+            std::vector<ValueType> merge(const std::vector<ValueType> &a, const std::vector<ValueType> &b) const
+            {
+                bounded_heap<ValueType, Compare> heap(k_, cmp_);
+                std::for_each(std::begin(a), std::end(a), [&](const ValueType &i){heap.push(i);});
+                std::for_each(std::begin(b), std::end(b), [&](const ValueType &i){heap.push(i);});
+                return heap.sorted();
+            }
+
+            std::size_t k_;
+            Compare cmp_;
+        };
+
+        template
+        <
+            typename KeyFunction,
+            typename Compare
+        >
+        struct top_k_by_type
+        {
+            constexpr top_k_by_type(const std::size_t &k, const KeyFunction &key, const Compare &cmp) : k_(k), key_(key), cmp_(cmp) {}
+
+            template
+            <
+                typename SequenceType,
+                typename ValueType = typename SequenceType::value_type,
+                typename KeyType = typename std::decay<typename std::result_of<KeyFunction(ValueType)>::type>::type
+            >
+            std::vector<ValueType> operator()(const SequenceType &sequence) const
+            {
+                return select<ValueType, KeyType>(std::begin(sequence), std::end(sequence));
+            }
+
+            template
+            <
+                typename ValueType,
+                typename KeyType = typename std::decay<typename std::result_of<KeyFunction(ValueType)>::type>::type
+            >
+            std::vector<ValueType> merge(const std::vector<ValueType> &a, const std::vector<ValueType> &b) const
+            {
+                std::vector<ValueType> joined(a);
+                joined.insert(std::end(joined), std::begin(b), std::end(b));
+                return select<ValueType, KeyType>(std::begin(joined), std::end(joined));
+            }
+
+            template
+            <
+                typename ValueType,
+                typename KeyType,
+                typename IterType
+            >
+            std::vector<ValueType> select(IterType begin, IterType end) const
+            {
+                using PairType = std::pair<KeyType, ValueType>;
+
+                bounded_heap<PairType, first_compare<Compare>> heap(k_, first_compare<Compare>(cmp_));
+                for(;begin != end; ++begin)
+                {
+                    heap.push(PairType(key_(*begin), *begin));
+                }
+
+                std::vector<PairType> pairs = heap.sorted();
+
+                std::vector<ValueType> result;
+                result.reserve(pairs.size());
+                for(PairType &i : pairs)
+                {
+                    result.push_back(std::move(i.second));
+                }
+                return result;
+            }
+
+            std::size_t k_;
+            KeyFunction key_;
+            Compare cmp_;
+        };
+
+        template
+        <
+            typename Compare,
+            typename ValueType
+        >
+        struct accumulator<top_k_type<Compare>, ValueType>
+        {
+            using result_type = std::vector<ValueType>;
+
+            accumulator(const top_k_type<Compare> &op) : heap_(op.k_, op.cmp_) {}
+
+            void push(const ValueType &val)
+            {
+                heap_.push(val);
+            }
+
+            result_type result() const
+            {
+                return heap_.sorted();
+            }
+
+            bounded_heap<ValueType, Compare> heap_;
+        };
+
+        //Keeps the key of each candidate beside it, so each element's key is computed once
+        template
+        <
+            typename KeyFunction,
+            typename Compare,
+            typename ValueType
+        >
+        struct accumulator<top_k_by_type<KeyFunction, Compare>, ValueType>
+        {
+            using key_type = typename std::decay<typename std::result_of<KeyFunction(ValueType)>::type>::type;
+            using pair_type = std::pair<key_type, ValueType>;
+            using result_type = std::vector<ValueType>;
+
+            accumulator(const top_k_by_type<KeyFunction, Compare> &op) : key_(op.key_), heap_(op.k_, first_compare<Compare>(op.cmp_)) {}
+
+            void push(const ValueType &val)
+            {
+                heap_.push(pair_type(key_(val), val));
+            }
+
+            result_type result() const
+            {
+                std::vector<pair_type> pairs = heap_.sorted();
+
+                result_type result;
+                result.reserve(pairs.size());
+                for(pair_type &i : pairs)
+                {
+                    result.push_back(std::move(i.second));
+                }
+                return result;
+            }
+
+            KeyFunction key_;
+            bounded_heap<pair_type, first_compare<Compare>> heap_;
+        };
+
+        template
+        <
+            typename Compare,
+            typename ValueType
+        >
+        struct mergeable_accumulator<top_k_type<Compare>, ValueType> : accumulator<top_k_type<Compare>, ValueType>
+        {
+            static const bool value = true;
+
+            mergeable_accumulator(const top_k_type<Compare> &op) : accumulator<top_k_type<Compare>, ValueType>(op) {}
+
+            void merge(const mergeable_accumulator &other)
+            {
+                this->heap_.merge(other.heap_);
+            }
+        };
+
+        template
+        <
+            typename KeyFunction,
+            typename Compare,
+            typename ValueType
+        >
+        struct mergeable_accumulator<top_k_by_type<KeyFunction, Compare>, ValueType> : accumulator<top_k_by_type<KeyFunction, Compare>, ValueType>
+        {
+            static const bool value = true;
+
+            mergeable_accumulator(const top_k_by_type<KeyFunction, Compare> &op) : accumulator<top_k_by_type<KeyFunction, Compare>, ValueType>(op) {}
+
+            void merge(const mergeable_accumulator &other)
+            {
+                this->heap_.merge(other.heap_);
+            }
+        };
+    }
+
+    template <typename Compare>
+    constexpr detail::top_k_type<Compare> top_k(const std::size_t &k, const Compare &cmp)
+    {
+        return detail::top_k_type<Compare>(k, cmp);
+    }
+
+    constexpr detail::top_k_type<detail::less_compare> top_k(const std::size_t &k)
+    {
+        return detail::top_k_type<detail::less_compare>(k, detail::less_compare());
+    }
+
+    template <typename Compare>
+    constexpr detail::top_k_type<detail::flip_compare<Compare>> bottom_k(const std::size_t &k, const Compare &cmp)
+    {
+        return detail::top_k_type<detail::flip_compare<Compare>>(k, detail::flip_compare<Compare>(cmp));
+    }
+
+    constexpr detail::top_k_type<detail::flip_compare<detail::less_compare>> bottom_k(const std::size_t &k)
+    {
+        return bottom_k(k, detail::less_compare());
+    }
+
+    template <typename KeyFunction>
+    constexpr detail::top_k_by_type<detail::projected_type<KeyFunction>, detail::less_compare> top_k_by(const std::size_t &k, const KeyFunction &key)
+    {
+        return detail::top_k_by_type<detail::projected_type<KeyFunction>, detail::less_compare>(k, key, detail::less_compare());
+    }
+
+    template <typename KeyFunction>
+    constexpr detail::top_k_by_type<detail::projected_type<KeyFunction>, detail::flip_compare<detail::less_compare>> bottom_k_by(const std::size_t &k, const KeyFunction &key)
+    {
+        return detail::top_k_by_type<detail::projected_type<KeyFunction>, detail::flip_compare<detail::less_compare>>(k, key, detail::flip_compare<detail::less_compare>(detail::less_compare()));
+    }
+}
+
+#endif
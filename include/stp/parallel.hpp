@@ -0,0 +1,466 @@
+#ifndef STP_PARALLEL_HPP
+#define STP_PARALLEL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace stp
+{
+    namespace detail
+    {
+        inline std::size_t hardware_workers()
+        {
+            const unsigned int workers = std::thread::hardware_concurrency();
+            return workers == 0 ? 1 : workers;
+        }
+
+        //Pins a thread to a single processor, where the platform supports it
+        inline void pin_thread(std::thread &thread, const unsigned int &cpu)
+        {
+#if defined(__linux__)
+            cpu_set_t cpus;
+            CPU_ZERO(&cpus);
+            CPU_SET(cpu, &cpus);
+            pthread_setaffinity_np(thread.native_handle(), sizeof(cpus), &cpus);
+#else
+            (void)thread;
+            (void)cpu;
+#endif
+        }
+
+        class thread_pool;
+
+        //The pool and index of the worker running on the current thread, if any
+        struct worker_identity
+        {
+            const thread_pool *pool_;
+            std::size_t index_;
+        };
+
+        inline worker_identity &current_worker()
+        {
+            static thread_local worker_identity identity = {nullptr, 0};
+            return identity;
+        }
+
+        //Each worker has its own queue of tasks. Tasks submitted by a worker go to the back of its own
+        //queue, and it takes from the back, so nested tasks run depth first. Idle workers, and threads
+        //waiting for a task group, steal from the front of the other queues.
+        class thread_pool
+        {
+            private:
+                struct task_queue
+                {
+                    std::mutex mutex_;
+                    std::deque<std::function<void()>> tasks_;
+                };
+
+            public:
+                thread_pool(const std::size_t &workers, const std::vector<unsigned int> &affinity) : queued_(0), next_(0), stop_(false)
+                {
+                    for(std::size_t i = 0; i < workers; ++i)
+                    {
+                        queues_.emplace_back(new task_queue());
+                    }
+
+                    for(std::size_t i = 0; i < workers; ++i)
+                    {
+                        threads_.emplace_back([this, i](){work(i);});
+
+                        if(!affinity.empty())
+                        {
+                            pin_thread(threads_.back(), affinity[i % affinity.size()]);
+                        }
+                    }
+                }
+
+                ~thread_pool()
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(sleep_mutex_);
+                        stop_ = true;
+                    }
+
+                    wake_.notify_all();
+
+                    for(std::thread &i : threads_)
+                    {
+                        i.join();
+                    }
+                }
+
+                thread_pool(const thread_pool &) = delete;
+                thread_pool &operator=(const thread_pool &) = delete;
+
+                std::size_t workers() const
+                {
+                    return threads_.size();
+                }
+
+                void submit(std::function<void()> task)
+                {
+                    if(queues_.empty())
+                    {
+                        task();
+                        return;
+                    }
+
+                    const worker_identity &self = current_worker();
+                    const std::size_t index = self.pool_ == this ? self.index_ : next_.fetch_add(1) % queues_.size();
+
+                    {
+                        std::lock_guard<std::mutex> lock(queues_[index]->mutex_);
+                        queues_[index]->tasks_.push_back(std::move(task));
+                    }
+
+                    {
+                        std::lock_guard<std::mutex> lock(sleep_mutex_);
+                        ++queued_;
+                    }
+
+                    wake_.notify_one();
+                }
+
+                //Runs a single queued task on the calling thread, returns false if there was none
+                bool run_one()
+                {
+                    std::function<void()> task;
+                    if(!take(task))
+                    {
+                        return false;
+                    }
+
+                    task();
+                    return true;
+                }
+
+            private:
+                bool take(std::function<void()> &task)
+                {
+                    const worker_identity &self = current_worker();
+                    const bool owner = self.pool_ == this;
+                    const std::size_t start = owner ? self.index_ : 0;
+
+                    for(std::size_t i = 0; i < queues_.size(); ++i)
+                    {
+                        task_queue &queue = *queues_[(start + i) % queues_.size()];
+
+                        std::lock_guard<std::mutex> lock(queue.mutex_);
+                        if(queue.tasks_.empty())
+                        {
+                            continue;
+                        }
+
+                        if(owner && i == 0)
+                        {
+                            task = std::move(queue.tasks_.back());
+                            queue.tasks_.pop_back();
+                        }
+                        else
+                        {
+                            task = std::move(queue.tasks_.front());
+                            queue.tasks_.pop_front();
+                        }
+
+                        --queued_;
+                        return true;
+                    }
+
+                    return false;
+                }
+
+                void work(const std::size_t &index)
+                {
+                    worker_identity &self = current_worker();
+                    self.pool_ = this;
+                    self.index_ = index;
+
+                    while(true)
+                    {
+                        if(run_one())
+                        {
+                            continue;
+                        }
+
+                        std::unique_lock<std::mutex> lock(sleep_mutex_);
+                        wake_.wait(lock, [this](){return stop_ || queued_.load() > 0;});
+
+                        if(stop_ && queued_.load() == 0)
+                        {
+                            return;
+                        }
+                    }
+                }
+
+                std::vector<std::unique_ptr<task_queue>> queues_;
+                std::vector<std::thread> threads_;
+                std::atomic<std::size_t> queued_;
+                std::atomic<std::size_t> next_;
+                std::mutex sleep_mutex_;
+                std::condition_variable wake_;
+                bool stop_;
+        };
+
+        struct pool_settings
+        {
+            std::mutex mutex_;
+            std::size_t workers_;
+            std::vector<unsigned int> affinity_;
+            bool started_;
+        };
+
+        //The calling thread helps while it waits, so one worker fewer than there are processors
+        inline pool_settings &default_pool_settings()
+        {
+            static pool_settings settings = {{}, hardware_workers() - 1, {}, false};
+            return settings;
+        }
+
+        inline thread_pool *make_default_pool()
+        {
+            pool_settings &settings = default_pool_settings();
+            std::lock_guard<std::mutex> lock(settings.mutex_);
+
+            settings.started_ = true;
+            return new thread_pool(settings.workers_, settings.affinity_);
+        }
+
+        inline thread_pool &default_pool()
+        {
+            static std::unique_ptr<thread_pool> pool(make_default_pool());
+            return *pool;
+        }
+
+        //The number of threads taking part in parallel operations, including the calling thread
+        inline std::size_t parallel_workers()
+        {
+            return default_pool().workers() + 1;
+        }
+
+        const std::size_t parallel_chunks_per_worker = 4;
+
+        //Splits n elements into chunks of at least grain elements, several per worker so that idle
+        //workers can steal. Chunks start at multiples of align, and the last chunk ends at n.
+        inline std::vector<std::size_t> parallel_chunks(const std::size_t &n, const std::size_t &grain, const std::size_t &align = 1)
+        {
+            const std::size_t workers = parallel_workers();
+            const std::size_t most = workers < 2 ? 1 : workers * parallel_chunks_per_worker;
+            const std::size_t wanted = n / grain;
+            const std::size_t chunks = wanted < 1 ? 1 : (wanted < most ? wanted : most);
+
+            std::vector<std::size_t> bounds(1, 0);
+            for(std::size_t i = 1; i < chunks; ++i)
+            {
+                const std::size_t bound = n / chunks * i / align * align;
+                if(bound > bounds.back())
+                {
+                    bounds.push_back(bound);
+                }
+            }
+
+            bounds.push_back(n);
+            return bounds;
+        }
+
+        //Tasks run on a thread pool, and wait() returns once all of them have finished. Waiting
+        //threads run queued tasks themselves, so tasks may wait for nested groups without deadlock.
+        class task_group
+        {
+            public:
+                explicit task_group(thread_pool &pool = default_pool()) : pool_(pool), pending_(0) {}
+
+                ~task_group()
+                {
+                    help();
+                }
+
+                task_group(const task_group &) = delete;
+                task_group &operator=(const task_group &) = delete;
+
+                template <typename Function>
+                void run(const Function &task)
+                {
+                    ++pending_;
+                    pool_.submit([this, task]()
+                    {
+                        try
+                        {
+                            task();
+                        }
+                        catch(...)
+                        {
+                            std::lock_guard<std::mutex> lock(error_mutex_);
+                            if(!error_)
+                            {
+                                error_ = std::current_exception();
+                            }
+                        }
+
+                        --pending_;
+                    });
+                }
+
+                //Rethrows the first exception thrown by any task
+                void wait()
+                {
+                    help();
+
+                    std::exception_ptr error;
+                    std::swap(error, error_);
+
+                    if(error)
+                    {
+                        std::rethrow_exception(error);
+                    }
+                }
+
+            private:
+                void help()
+                {
+                    while(pending_.load() > 0)
+                    {
+                        if(!pool_.run_one())
+                        {
+                            std::this_thread::yield();
+                        }
+                    }
+                }
+
+                thread_pool &pool_;
+                std::atomic<std::size_t> pending_;
+                std::mutex error_mutex_;
+                std::exception_ptr error_;
+        };
+
+        //Calls task(i) for every i in [0, n), using the calling thread for i == 0
+        //The first exception thrown by any task is rethrown once all tasks have finished
+        template <typename Function>
+        void parallel_for(thread_pool &pool, const std::size_t &n, const Function &task)
+        {
+            if(n == 0)
+            {
+                return;
+            }
+
+            task_group group(pool);
+            for(std::size_t i = 1; i < n; ++i)
+            {
+                group.run([&task, i](){task(i);});
+            }
+
+            std::exception_ptr error;
+            try
+            {
+                task(0);
+            }
+            catch(...)
+            {
+                error = std::current_exception();
+            }
+
+            try
+            {
+                group.wait();
+            }
+            catch(...)
+            {
+                if(!error)
+                {
+                    error = std::current_exception();
+                }
+            }
+
+            if(error)
+            {
+                std::rethrow_exception(error);
+            }
+        }
+
+        template <typename Function>
+        void parallel_for(const std::size_t &n, const Function &task)
+        {
+            parallel_for(default_pool(), n, task);
+        }
+
+        //Like parallel_for, but each task gets a thread of its own rather than a share of the pool,
+        //for tasks which wait for each other and so must all run at the same time
+        template <typename Function>
+        void spawn_for(const std::size_t &n, const Function &task)
+        {
+            std::vector<std::exception_ptr> errors(n);
+            std::vector<std::thread> threads;
+
+            for(std::size_t i = 1; i < n; ++i)
+            {
+                threads.emplace_back([&task, &errors, i]()
+                {
+                    try
+                    {
+                        task(i);
+                    }
+                    catch(...)
+                    {
+                        errors[i] = std::current_exception();
+                    }
+                });
+            }
+
+            if(n > 0)
+            {
+                try
+                {
+                    task(0);
+                }
+                catch(...)
+                {
+                    errors[0] = std::current_exception();
+                }
+            }
+
+            for(std::thread &i : threads)
+            {
+                i.join();
+            }
+
+            for(const std::exception_ptr &i : errors)
+            {
+                if(i)
+                {
+                    std::rethrow_exception(i);
+                }
+            }
+        }
+    }
+
+    //Sets the number of worker threads, and optionally the processors they are pinned to, of the
+    //pool used by parallel operations. Must be called before the first parallel operation.
+    inline void configure_thread_pool(const std::size_t &workers, const std::vector<unsigned int> &affinity = std::vector<unsigned int>())
+    {
+        detail::pool_settings &settings = detail::default_pool_settings();
+        std::lock_guard<std::mutex> lock(settings.mutex_);
+
+        if(settings.started_)
+        {
+            throw std::logic_error("The thread pool has already started");
+        }
+
+        settings.workers_ = workers;
+        settings.affinity_ = affinity;
+    }
+}
+
+#endif
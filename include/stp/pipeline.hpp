@@ -2,6 +2,9 @@
 #define STP_PIPELINE_HPP
 
 #include <type_traits>
+#include <utility>
+
+#include "traits.hpp"
 
 namespace stp
 {
@@ -25,16 +28,16 @@ namespace stp
                 template <typename SequenceType>
                 using return_type = typename base_type::template return_type<op_return_type<SequenceType>>;
 
-                stp_type(OpType operation, Rest... rest) : base_type(rest...), operation_(operation) {}
+                constexpr stp_type(OpType operation, Rest... rest) : base_type(rest...), operation_(operation) {}
 
                 template <typename SequenceType>
-                return_type<SequenceType> operator()(SequenceType sequence) const
+                constexpr return_type<SequenceType> operator()(SequenceType &&sequence) const
                 {
                     using base_return = typename std::result_of<base_type(op_return_type<SequenceType>)>::type;
                     using this_return = typename std::result_of<this_type(SequenceType)>::type;
                     static_assert(std::is_same<base_return, this_return>::value, "Pipeline type mismatch");
 
-                    return base_type::operator()(operation_(sequence));
+                    return base_type::operator()(operation_(std::forward<SequenceType>(sequence)));
                 }
 
             private:
@@ -46,14 +49,14 @@ namespace stp
         {
             public:
                 template <typename SequenceType>
-                using return_type = typename std::result_of<OpType(SequenceType)>::type;
+                using return_type = tail_type<typename std::result_of<OpType(SequenceType)>::type>;
 
-                stp_type(OpType operation) : operation_(operation) {}
+                constexpr stp_type(OpType operation) : operation_(operation) {}
 
                 template <typename SequenceType>
-                return_type<SequenceType> operator()(SequenceType sequence) const
+                constexpr return_type<SequenceType> operator()(SequenceType &&sequence) const
                 {
-                    return operation_(sequence);
+                    return operation_(std::forward<SequenceType>(sequence));
                 }
 
             private:
@@ -66,7 +69,7 @@ namespace stp
         typename OpType,
         typename ...Rest
     >
-    detail::stp_type<OpType, Rest...> make_stp(OpType operation, Rest... rest)
+    constexpr detail::stp_type<OpType, Rest...> make_stp(OpType operation, Rest... rest)
     {
         return detail::stp_type<OpType, Rest...>(operation, rest...);
     }
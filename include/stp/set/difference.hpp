@@ -4,6 +4,8 @@
 #include <iterator>
 #include <type_traits>
 
+#include "../traits.hpp"
+
 namespace stp
 {
     namespace detail
@@ -23,7 +25,7 @@ namespace stp
                 typename ValueType = typename SequenceType::value_type,
                 typename = typename std::enable_if<std::is_same<ValueType, FixedValueType>::value>::type
             >
-            SequenceType operator()(const SequenceType &sequence) const
+            owned_type<SequenceType> operator()(const SequenceType &sequence) const
             {
                 auto begin = std::begin(sequence);
                 auto end = std::end(sequence);
@@ -31,7 +33,7 @@ namespace stp
                 auto begin_fixed = std::begin(fixed_sequence_);
                 auto end_fixed = std::end(fixed_sequence_);
 
-                SequenceType result;
+                owned_type<SequenceType> result;
                 for(;begin != end; ++begin)
                 {
                     if(begin_fixed == end_fixed)
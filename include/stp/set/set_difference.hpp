@@ -0,0 +1,111 @@
+#ifndef STP_SET_DIFFERENCE_HPP
+#define STP_SET_DIFFERENCE_HPP
+
+#include <iterator>
+#include <type_traits>
+#include <unordered_set>
+
+#include "../tags.hpp"
+#include "../traits.hpp"
+
+namespace stp
+{
+    namespace detail
+    {
+        template
+        <
+            typename FixedSequenceType,
+            typename FixedValueType = typename FixedSequenceType::value_type
+        >
+        struct set_difference_type
+        {
+            set_difference_type(const FixedSequenceType &sequence) : fixed_set_(std::begin(sequence), std::end(sequence)) {}
+
+            template
+            <
+                typename SequenceType,
+                typename ValueType = typename SequenceType::value_type,
+                typename = typename std::enable_if<std::is_same<ValueType, FixedValueType>::value>::type
+            >
+            owned_type<SequenceType> operator()(const SequenceType &sequence) const
+            {
+                std::unordered_set<ValueType> emitted;
+
+                owned_type<SequenceType> result;
+                for(const ValueType &i : sequence)
+                {
+                    if(fixed_set_.count(i) == 0 && emitted.insert(i).second)
+                    {
+                        result.push_back(i);
+                    }
+                }
+                return result;
+            }
+
+            std::unordered_set<FixedValueType> fixed_set_;
+        };
+
+        template
+        <
+            typename FixedSequenceType,
+            typename FixedValueType = typename FixedSequenceType::value_type
+        >
+        struct sorted_set_difference_type
+        {
+            sorted_set_difference_type(const FixedSequenceType &sequence) : fixed_sequence_(sequence) {}
+
+            template
+            <
+                typename SequenceType,
+                typename ValueType = typename SequenceType::value_type,
+                typename = typename std::enable_if<std::is_same<ValueType, FixedValueType>::value>::type
+            >
+            owned_type<SequenceType> operator()(const SequenceType &sequence) const
+            {
+                auto begin = std::begin(sequence);
+                auto end = std::end(sequence);
+
+                auto begin_fixed = std::begin(fixed_sequence_);
+                auto end_fixed = std::end(fixed_sequence_);
+
+                owned_type<SequenceType> result;
+                while(begin != end)
+                {
+                    if(begin_fixed == end_fixed || *begin < *begin_fixed)
+                    {
+                        if(result.empty() || result.back() < *begin)
+                        {
+                            result.push_back(*begin);
+                        }
+                        ++begin;
+                    }
+                    else if(*begin_fixed < *begin)
+                    {
+                        ++begin_fixed;
+                    }
+                    else
+                    {
+                        ++begin;
+                    }
+                }
+                return result;
+            }
+
+            FixedSequenceType fixed_sequence_;
+        };
+    }
+
+    template <typename SequenceType>
+    detail::set_difference_type<SequenceType> set_difference(const SequenceType &sequence)
+    {
+        return detail::set_difference_type<SequenceType>(sequence);
+    }
+
+    template <typename SequenceType>
+    detail::sorted_set_difference_type<SequenceType> set_difference(const SequenceType &sequence, detail::sorted_tag)
+    {
+        return detail::sorted_set_difference_type<SequenceType>(sequence);
+    }
+}
+
+#endif
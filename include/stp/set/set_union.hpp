@@ -0,0 +1,142 @@
+#ifndef STP_SET_UNION_HPP
+#define STP_SET_UNION_HPP
+
+#include <iterator>
+#include <type_traits>
+#include <unordered_set>
+#include <vector>
+
+#include "../tags.hpp"
+#include "../traits.hpp"
+
+namespace stp
+{
+    namespace detail
+    {
+        template
+        <
+            typename FixedSequenceType,
+            typename FixedValueType = typename FixedSequenceType::value_type
+        >
+        struct set_union_type
+        {
+            set_union_type(const FixedSequenceType &sequence)
+            {
+                std::unordered_set<FixedValueType> emitted;
+                for(const FixedValueType &i : sequence)
+                {
+                    if(emitted.insert(i).second)
+                    {
+                        fixed_distinct_.push_back(i);
+                    }
+                }
+            }
+
+            template
+            <
+                typename SequenceType,
+                typename ValueType = typename SequenceType::value_type,
+                typename = typename std::enable_if<std::is_same<ValueType, FixedValueType>::value>::type
+            >
+            owned_type<SequenceType> operator()(const SequenceType &sequence) const
+            {
+                std::unordered_set<ValueType> emitted;
+
+                owned_type<SequenceType> result;
+                for(const ValueType &i : sequence)
+                {
+                    if(emitted.insert(i).second)
+                    {
+                        result.push_back(i);
+                    }
+                }
+
+                for(const ValueType &i : fixed_distinct_)
+                {
+                    if(emitted.count(i) == 0)
+                    {
+                        result.push_back(i);
+                    }
+                }
+                return result;
+            }
+
+            std::vector<FixedValueType> fixed_distinct_;
+        };
+
+        template
+        <
+            typename FixedSequenceType,
+            typename FixedValueType = typename FixedSequenceType::value_type
+        >
+        struct sorted_set_union_type
+        {
+            sorted_set_union_type(const FixedSequenceType &sequence) : fixed_sequence_(sequence) {}
+
+            template
+            <
+                typename SequenceType,
+                typename ValueType = typename SequenceType::value_type,
+                typename = typename std::enable_if<std::is_same<ValueType, FixedValueType>::value>::type
+            >
+            owned_type<SequenceType> operator()(const SequenceType &sequence) const
+            {
+                auto begin = std::begin(sequence);
+                auto end = std::end(sequence);
+
+                auto begin_fixed = std::begin(fixed_sequence_);
+                auto end_fixed = std::end(fixed_sequence_);
+
+                owned_type<SequenceType> result;
+                auto emit = [&](const ValueType &i)
+                {
+                    if(result.empty() || result.back() < i)
+                    {
+                        result.push_back(i);
+                    }
+                };
+
+                while(begin != end && begin_fixed != end_fixed)
+                {
+                    if(*begin_fixed < *begin)
+                    {
+                        emit(*begin_fixed);
+                        ++begin_fixed;
+                    }
+                    else
+                    {
+                        emit(*begin);
+                        ++begin;
+                    }
+                }
+
+                for(;begin != end; ++begin)
+                {
+                    emit(*begin);
+                }
+
+                for(;begin_fixed != end_fixed; ++begin_fixed)
+                {
+                    emit(*begin_fixed);
+                }
+                return result;
+            }
+
+            FixedSequenceType fixed_sequence_;
+        };
+    }
+
+    template <typename SequenceType>
+    detail::set_union_type<SequenceType> set_union(const SequenceType &sequence)
+    {
+        return detail::set_union_type<SequenceType>(sequence);
+    }
+
+    template <typename SequenceType>
+    detail::sorted_set_union_type<SequenceType> set_union(const SequenceType &sequence, detail::sorted_tag)
+    {
+        return detail::sorted_set_union_type<SequenceType>(sequence);
+    }
+}
+
+#endif
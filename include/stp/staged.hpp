@@ -0,0 +1,404 @@
+#ifndef STP_STAGED_HPP
+#define STP_STAGED_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "accumulator.hpp"
+#include "parallel.hpp"
+
+namespace stp
+{
+    namespace detail
+    {
+        const std::size_t cache_line_size = 64;
+
+        //Occupancy of a queue between two stages, sampled each time a batch is pushed.
+        //A queue which is often full belongs to a slow consumer, one which is often empty to a slow producer.
+        struct queue_stats
+        {
+            double mean_occupancy() const
+            {
+                return batches == 0 ? 0.0 : static_cast<double>(occupancy_sum) / static_cast<double>(batches);
+            }
+
+            std::size_t capacity;
+            std::size_t batches;
+            std::size_t occupancy_sum;
+            std::size_t max_occupancy;
+            std::size_t full_waits;
+        };
+
+        //Keeps the positions of the producer and the consumer on separate cache lines
+        struct padded_index
+        {
+            padded_index() : value(0) {}
+
+            std::atomic<std::size_t> value;
+            char pad[cache_line_size - sizeof(std::atomic<std::size_t>)];
+        };
+
+        //A bounded lock-free queue for exactly one producer and one consumer thread. A full queue
+        //blocks the producer until the consumer catches up. Either side stops waiting once abort is set.
+        template <typename ValueType>
+        class spsc_queue
+        {
+            public:
+                spsc_queue(const std::size_t &capacity, const std::atomic<bool> &abort)
+                    : slots_(capacity + 1), abort_(abort), closed_(false), stats_{capacity, 0, 0, 0, 0} {}
+
+                bool push(ValueType &&val)
+                {
+                    const std::size_t tail = tail_.value.load(std::memory_order_relaxed);
+                    const std::size_t next = (tail + 1) % slots_.size();
+
+                    if(next == head_.value.load(std::memory_order_acquire))
+                    {
+                        ++stats_.full_waits;
+                        while(next == head_.value.load(std::memory_order_acquire))
+                        {
+                            if(abort_.load(std::memory_order_relaxed))
+                            {
+                                return false;
+                            }
+
+                            std::this_thread::yield();
+                        }
+                    }
+
+                    slots_[tail] = std::move(val);
+                    tail_.value.store(next, std::memory_order_release);
+
+                    const std::size_t occupancy = (next + slots_.size() - head_.value.load(std::memory_order_acquire)) % slots_.size();
+                    ++stats_.batches;
+                    stats_.occupancy_sum += occupancy;
+                    stats_.max_occupancy = occupancy > stats_.max_occupancy ? occupancy : stats_.max_occupancy;
+
+                    return true;
+                }
+
+                //Returns false once the queue is closed and empty, or on abort
+                bool pop(ValueType &val)
+                {
+                    const std::size_t head = head_.value.load(std::memory_order_relaxed);
+
+                    while(head == tail_.value.load(std::memory_order_acquire))
+                    {
+                        if(closed_.load(std::memory_order_acquire))
+                        {
+                            if(head == tail_.value.load(std::memory_order_acquire))
+                            {
+                                return false;
+                            }
+
+                            break;
+                        }
+
+                        if(abort_.load(std::memory_order_relaxed))
+                        {
+                            return false;
+                        }
+
+                        std::this_thread::yield();
+                    }
+
+                    val = std::move(slots_[head]);
+                    head_.value.store((head + 1) % slots_.size(), std::memory_order_release);
+                    return true;
+                }
+
+                void close()
+                {
+                    closed_.store(true, std::memory_order_release);
+                }
+
+                //Only meaningful once the producer has finished
+                const queue_stats &stats() const
+                {
+                    return stats_;
+                }
+
+            private:
+                std::vector<ValueType> slots_;
+                const std::atomic<bool> &abort_;
+                padded_index head_;
+                padded_index tail_;
+                std::atomic<bool> closed_;
+                queue_stats stats_;
+        };
+
+        //The type of the elements after the first N operations
+        template
+        <
+            typename ValueType,
+            std::size_t N,
+            typename ...OpTypes
+        >
+        struct stage_value
+        {
+            using type = ValueType;
+        };
+
+        template
+        <
+            typename ValueType,
+            typename OpType,
+            typename ...Rest
+        >
+        struct stage_value<ValueType, 0, OpType, Rest...>
+        {
+            using type = ValueType;
+        };
+
+        template
+        <
+            typename ValueType,
+            std::size_t N,
+            typename OpType,
+            typename ...Rest
+        >
+        struct stage_value<ValueType, N, OpType, Rest...> : stage_value<typename element_op<OpType>::template output_type<ValueType>, N - 1, Rest...> {};
+
+        template <typename ValueType>
+        struct batch_collector
+        {
+            template <typename ElementType>
+            void operator()(const ElementType &val)
+            {
+                batch_->push_back(val);
+            }
+
+            std::vector<ValueType> *batch_;
+        };
+
+        //Evaluates element-wise operations followed by a reduction, with each element-wise operation
+        //on its own thread and the reduction on the calling thread. Elements are passed between threads
+        //in batches through bounded queues, so the order of the elements is preserved and operations
+        //may keep state between elements.
+        template
+        <
+            typename SequenceType,
+            typename ...OpTypes
+        >
+        class staged_type
+        {
+            private:
+                using op_tuple = std::tuple<OpTypes...>;
+
+                static const std::size_t stages = sizeof...(OpTypes) - 1;
+
+                using terminal_type = typename std::tuple_element<stages, op_tuple>::type;
+                using input_type = typename SequenceType::value_type;
+                using accumulator_type = accumulator<terminal_type, typename stage_value<input_type, stages, OpTypes...>::type>;
+
+                template <std::size_t I>
+                using batch_type = std::vector<typename stage_value<input_type, I + 1, OpTypes...>::type>;
+
+                template <typename IndexType>
+                struct queue_tuple;
+
+                template <std::size_t ...I>
+                struct queue_tuple<index_sequence<I...>>
+                {
+                    using type = std::tuple<std::unique_ptr<spsc_queue<batch_type<I>>>...>;
+                };
+
+                using queues_type = typename queue_tuple<typename make_index_sequence<stages>::type>::type;
+
+            public:
+                using result_type = typename accumulator_type::result_type;
+
+                staged_type(const std::size_t &batch_size, const std::size_t &capacity, OpTypes... ops)
+                    : ops_(ops...), batch_size_(batch_size), capacity_(capacity) {}
+
+                result_type operator()(const SequenceType &sequence)
+                {
+                    std::atomic<bool> abort(false);
+                    queues_type queues;
+                    make_queues(queues, abort, typename make_index_sequence<stages>::type());
+
+                    accumulator_type acc(std::get<stages>(ops_));
+
+                    spawn_for(stages + 1, [&](std::size_t i)
+                    {
+                        try
+                        {
+                            if(i == 0)
+                            {
+                                reduce(queues, acc, std::integral_constant<bool, stages == 0>(), sequence);
+                            }
+                            else
+                            {
+                                dispatch(std::integral_constant<std::size_t, 0>(), i - 1, queues, sequence);
+                            }
+                        }
+                        catch(...)
+                        {
+                            abort.store(true);
+                            throw;
+                        }
+                    });
+
+                    collect_stats(queues, typename make_index_sequence<stages>::type());
+                    return acc.result();
+                }
+
+                //The occupancy of the queue after each element-wise operation during the last evaluation
+                const std::vector<queue_stats> &stats() const
+                {
+                    return stats_;
+                }
+
+            private:
+                template <std::size_t ...I>
+                void make_queues(queues_type &queues, const std::atomic<bool> &abort, index_sequence<I...>) const
+                {
+                    int expand[] = {0, (std::get<I>(queues).reset(new spsc_queue<batch_type<I>>(capacity_, abort)), 0)...};
+                    (void)expand;
+                }
+
+                template <std::size_t ...I>
+                void collect_stats(const queues_type &queues, index_sequence<I...>)
+                {
+                    stats_.clear();
+
+                    int expand[] = {0, (stats_.push_back(std::get<I>(queues)->stats()), 0)...};
+                    (void)expand;
+                }
+
+                template <std::size_t I>
+                void dispatch(std::integral_constant<std::size_t, I>, const std::size_t &stage, queues_type &queues, const SequenceType &sequence)
+                {
+                    if(stage == I)
+                    {
+                        run_stage<I>(queues, sequence, std::integral_constant<bool, I == 0>());
+                    }
+                    else
+                    {
+                        dispatch(std::integral_constant<std::size_t, I + 1>(), stage, queues, sequence);
+                    }
+                }
+
+                void dispatch(std::integral_constant<std::size_t, stages>, const std::size_t &, queues_type &, const SequenceType &) {}
+
+                //The first operation reads the sequence directly
+                template <std::size_t I>
+                void run_stage(queues_type &queues, const SequenceType &sequence, std::true_type)
+                {
+                    batch_type<I> batch;
+                    for(const input_type &i : sequence)
+                    {
+                        if(!apply<I>(queues, i, batch))
+                        {
+                            return;
+                        }
+                    }
+
+                    finish<I>(queues, batch);
+                }
+
+                template <std::size_t I>
+                void run_stage(queues_type &queues, const SequenceType &, std::false_type)
+                {
+                    batch_type<I> batch;
+                    batch_type<I - 1> input;
+                    while(std::get<I - 1>(queues)->pop(input))
+                    {
+                        for(const typename batch_type<I - 1>::value_type &i : input)
+                        {
+                            if(!apply<I>(queues, i, batch))
+                            {
+                                return;
+                            }
+                        }
+                    }
+
+                    finish<I>(queues, batch);
+                }
+
+                //Returns false if the pipeline has been aborted
+                template
+                <
+                    std::size_t I,
+                    typename ValueType
+                >
+                bool apply(queues_type &queues, const ValueType &val, batch_type<I> &batch)
+                {
+                    batch_collector<typename batch_type<I>::value_type> next = {&batch};
+                    element_op<typename std::tuple_element<I, op_tuple>::type>::apply(std::get<I>(ops_), val, next);
+
+                    if(batch.size() < batch_size_)
+                    {
+                        return true;
+                    }
+
+                    bool pushed = std::get<I>(queues)->push(std::move(batch));
+                    batch = batch_type<I>();
+                    batch.reserve(batch_size_);
+                    return pushed;
+                }
+
+                template <std::size_t I>
+                void finish(queues_type &queues, batch_type<I> &batch)
+                {
+                    if(!batch.empty())
+                    {
+                        std::get<I>(queues)->push(std::move(batch));
+                    }
+
+                    std::get<I>(queues)->close();
+                }
+
+                void reduce(queues_type &, accumulator_type &acc, std::true_type, const SequenceType &sequence)
+                {
+                    for(const input_type &i : sequence)
+                    {
+                        acc.push(i);
+                    }
+                }
+
+                void reduce(queues_type &queues, accumulator_type &acc, std::false_type, const SequenceType &)
+                {
+                    using last_type = batch_type<(stages == 0 ? 0 : stages - 1)>;
+
+                    last_type batch;
+                    while(std::get<(stages == 0 ? 0 : stages - 1)>(queues)->pop(batch))
+                    {
+                        for(const typename last_type::value_type &i : batch)
+                        {
+                            acc.push(i);
+                        }
+                    }
+                }
+
+                op_tuple ops_;
+                std::size_t batch_size_;
+                std::size_t capacity_;
+                std::vector<queue_stats> stats_;
+        };
+    }
+
+    template
+    <
+        typename SequenceType,
+        typename ...OpTypes
+    >
+    detail::staged_type<SequenceType, OpTypes...> make_staged(const std::size_t &batch_size, const std::size_t &capacity, OpTypes... ops)
+    {
+        if(batch_size == 0 || capacity == 0)
+        {
+            throw std::invalid_argument("Batch size and queue capacity must be positive");
+        }
+
+        return detail::staged_type<SequenceType, OpTypes...>(batch_size, capacity, ops...);
+    }
+}
+
+#endif
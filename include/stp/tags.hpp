@@ -0,0 +1,18 @@
+#ifndef STP_TAGS_HPP
+#define STP_TAGS_HPP
+
+namespace stp
+{
+    namespace detail
+    {
+        struct exact_tag {};
+        struct par_tag {};
+        struct sorted_tag {};
+    }
+
+    const detail::exact_tag exact = detail::exact_tag();
+    const detail::par_tag par = detail::par_tag();
+    const detail::sorted_tag sorted = detail::sorted_tag();
+}
+
+#endif
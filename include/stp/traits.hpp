@@ -0,0 +1,160 @@
+#ifndef STP_TRAITS_HPP
+#define STP_TRAITS_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace stp
+{
+    namespace detail
+    {
+        template <typename SequenceType>
+        struct is_contiguous : std::false_type {};
+
+        template
+        <
+            typename ValueType,
+            typename AllocatorType
+        >
+        struct is_contiguous<std::vector<ValueType, AllocatorType>> : std::integral_constant<bool, !std::is_same<ValueType, bool>::value> {};
+
+        template
+        <
+            typename ValueType,
+            std::size_t N
+        >
+        struct is_contiguous<std::array<ValueType, N>> : std::true_type {};
+
+        //Base class of lazy sequences which refer to or wrap another sequence instead of holding their own elements
+        struct view_base {};
+
+        template <typename SequenceType>
+        struct is_view : std::is_base_of<view_base, typename std::decay<SequenceType>::type> {};
+
+        //Operations which modify their input or build a sequence of the same type produce this type instead of a view
+        template
+        <
+            typename SequenceType,
+            bool = is_view<SequenceType>::value
+        >
+        struct owned
+        {
+            using type = SequenceType;
+        };
+
+        template <typename SequenceType>
+        struct owned<SequenceType, true>
+        {
+            using type = std::vector<typename SequenceType::value_type>;
+        };
+
+        template <typename SequenceType>
+        using owned_type = typename owned<SequenceType>::type;
+
+        //The type a result is converted to at the end of a transformation, and before operations which depend on
+        //the type of their input. Views which only save work between operations, rather than being returned on
+        //purpose, specialize it as the type of sequence they stand in for.
+        template <typename SequenceType>
+        struct tail
+        {
+            using type = SequenceType;
+        };
+
+        template <typename SequenceType>
+        using tail_type = typename tail<SequenceType>::type;
+
+        template <typename SequenceType>
+        struct is_transient : std::integral_constant<bool, !std::is_same<tail_type<SequenceType>, SequenceType>::value> {};
+
+        template <typename ViewType>
+        owned_type<ViewType> materialize(const ViewType &view)
+        {
+            return owned_type<ViewType>(std::begin(view), std::end(view));
+        }
+
+        template
+        <
+            typename LeftType,
+            typename RightType,
+            typename = typename std::enable_if<is_view<LeftType>::value || is_view<RightType>::value>::type
+        >
+        bool operator==(const LeftType &left, const RightType &right)
+        {
+            return std::distance(std::begin(left), std::end(left)) == std::distance(std::begin(right), std::end(right)) &&
+                   std::equal(std::begin(left), std::end(left), std::begin(right));
+        }
+
+        template
+        <
+            typename LeftType,
+            typename RightType,
+            typename = typename std::enable_if<is_view<LeftType>::value || is_view<RightType>::value>::type
+        >
+        bool operator!=(const LeftType &left, const RightType &right)
+        {
+            return !(left == right);
+        }
+
+        //Reads a data member, or calls a const member function, of an element passed by reference, so that
+        //a pointer to member can be given wherever a function of an element is expected
+        template
+        <
+            typename MemberType,
+            bool = std::is_member_function_pointer<MemberType>::value
+        >
+        struct projection
+        {
+            constexpr projection(MemberType member) : member_(member) {}
+
+            template <typename ClassType>
+            auto operator()(const ClassType &obj) const -> decltype(obj.*std::declval<MemberType>())
+            {
+                return obj.*member_;
+            }
+
+            MemberType member_;
+        };
+
+        template <typename MemberType>
+        struct projection<MemberType, true>
+        {
+            constexpr projection(MemberType member) : member_(member) {}
+
+            template <typename ClassType>
+            auto operator()(const ClassType &obj) const -> decltype((obj.*std::declval<MemberType>())())
+            {
+                return (obj.*member_)();
+            }
+
+            MemberType member_;
+        };
+
+        template <typename FunctionType>
+        using projected_type = typename std::conditional<std::is_member_pointer<FunctionType>::value, projection<FunctionType>, FunctionType>::type;
+
+        struct less_compare
+        {
+            template <typename ValueType>
+            bool operator()(const ValueType &a, const ValueType &b) const
+            {
+                return a < b;
+            }
+        };
+
+        struct greater_compare
+        {
+            template <typename ValueType>
+            bool operator()(const ValueType &a, const ValueType &b) const
+            {
+                return b < a;
+            }
+        };
+    }
+}
+
+#endif
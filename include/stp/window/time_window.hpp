@@ -0,0 +1,219 @@
+#ifndef STP_TIME_WINDOW_HPP
+#define STP_TIME_WINDOW_HPP
+
+#include <cmath>
+#include <limits>
+#include <map>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../accumulator.hpp"
+
+namespace stp
+{
+    namespace detail
+    {
+        template <typename TimeType>
+        bool is_negative(const TimeType &val, std::true_type)
+        {
+            return val < 0;
+        }
+
+        template <typename TimeType>
+        bool is_negative(const TimeType &, std::false_type)
+        {
+            return false;
+        }
+
+        //Rounds down to a multiple of slide
+        template <typename TimeType>
+        TimeType align_down(const TimeType &val, const TimeType &slide, std::true_type)
+        {
+            return std::floor(val / slide) * slide;
+        }
+
+        template <typename TimeType>
+        TimeType align_down(const TimeType &val, const TimeType &slide, std::false_type)
+        {
+            const TimeType rem = val % slide;
+            return is_negative(rem, std::is_signed<TimeType>()) ? val - rem - slide : val - rem;
+        }
+
+        //Windows cover [start, start + size) for every start which is a multiple of slide. A window
+        //is closed, and its result emitted, as soon as an element with a timestamp at or past its end
+        //arrives. Elements arriving later than that are only added to windows which are still open,
+        //so at most size / slide + 1 windows are held at any time.
+        template
+        <
+            typename OpType,
+            typename ValueType,
+            typename TimeFunction,
+            typename TimeType
+        >
+        class time_window_state
+        {
+            public:
+                using result_type = typename accumulator<OpType, ValueType>::result_type;
+                using window_result = std::pair<TimeType, result_type>;
+
+                time_window_state(const TimeFunction &time, const TimeType &size, const TimeType &slide, const OpType &op)
+                    : time_(time), size_(size), slide_(slide), op_(op), started_(false), watermark_() {}
+
+                //Adds an element, and returns the start and result of every window it closed, oldest first
+                std::vector<window_result> push(const ValueType &val)
+                {
+                    const TimeType t = time_(val);
+
+                    std::vector<window_result> closed;
+                    if(!started_ || watermark_ < t)
+                    {
+                        watermark_ = t;
+                        started_ = true;
+                        close(closed);
+                    }
+
+                    TimeType start = align_down(t, slide_, std::is_floating_point<TimeType>());
+                    while(t < start + size_)
+                    {
+                        if(watermark_ < start + size_)
+                        {
+                            auto it = windows_.find(start);
+                            if(it == windows_.end())
+                            {
+                                it = windows_.insert(std::make_pair(start, accumulator<OpType, ValueType>(op_))).first;
+                            }
+
+                            it->second.push(val);
+                        }
+
+                        if(start < std::numeric_limits<TimeType>::lowest() + slide_)
+                        {
+                            break;
+                        }
+
+                        start -= slide_;
+                    }
+
+                    return closed;
+                }
+
+                //Closes every open window, for the end of a finite sequence
+                std::vector<window_result> flush()
+                {
+                    std::vector<window_result> closed;
+                    for(const std::pair<const TimeType, accumulator<OpType, ValueType>> &i : windows_)
+                    {
+                        closed.push_back(window_result(i.first, i.second.result()));
+                    }
+
+                    windows_.clear();
+                    return closed;
+                }
+
+                std::size_t open_windows() const
+                {
+                    return windows_.size();
+                }
+
+            private:
+                void close(std::vector<window_result> &closed)
+                {
+                    while(!windows_.empty() && !(watermark_ < windows_.begin()->first + size_))
+                    {
+                        closed.push_back(window_result(windows_.begin()->first, windows_.begin()->second.result()));
+                        windows_.erase(windows_.begin());
+                    }
+                }
+
+                TimeFunction time_;
+                TimeType size_;
+                TimeType slide_;
+                OpType op_;
+                bool started_;
+                TimeType watermark_;
+                std::map<TimeType, accumulator<OpType, ValueType>> windows_;
+        };
+
+        template
+        <
+            typename TimeFunction,
+            typename TimeType,
+            typename OpType
+        >
+        struct time_window_type
+        {
+            time_window_type(const TimeFunction &time, const TimeType &size, const TimeType &slide, const OpType &op)
+                : time_(time), size_(size), slide_(slide), op_(op) {}
+
+            template
+            <
+                typename SequenceType,
+                typename ValueType = typename SequenceType::value_type,
+                typename StampType = typename std::decay<typename std::result_of<TimeFunction(ValueType)>::type>::type,
+                typename = typename std::enable_if<std::is_convertible<StampType, TimeType>::value>::type,
+                typename ResultType = typename time_window_state<OpType, ValueType, TimeFunction, TimeType>::window_result
+            >
+            std::vector<ResultType> operator()(const SequenceType &sequence) const
+            {
+                time_window_state<OpType, ValueType, TimeFunction, TimeType> window = state<ValueType>();
+
+                std::vector<ResultType> result;
+                for(const ValueType &i : sequence)
+                {
+                    std::vector<ResultType> closed = window.push(i);
+                    result.insert(result.end(), closed.begin(), closed.end());
+                }
+
+                std::vector<ResultType> remaining = window.flush();
+                result.insert(result.end(), remaining.begin(), remaining.end());
+
+                return result;
+            }
+
+            //Returns a window state without any elements, for aggregating an unbounded stream
+            template <typename ValueType>
+            time_window_state<OpType, ValueType, TimeFunction, TimeType> state() const
+            {
+                return time_window_state<OpType, ValueType, TimeFunction, TimeType>(time_, size_, slide_, op_);
+            }
+
+            TimeFunction time_;
+            TimeType size_;
+            TimeType slide_;
+            OpType op_;
+        };
+    }
+
+    template
+    <
+        typename TimeFunction,
+        typename TimeType,
+        typename OpType
+    >
+    detail::time_window_type<TimeFunction, TimeType, OpType> time_window(const TimeFunction &time, const TimeType &size, const TimeType &slide, const OpType &op)
+    {
+        static_assert(std::is_arithmetic<TimeType>::value, "Window size and slide must be arithmetic");
+
+        if(!(TimeType() < size) || !(TimeType() < slide))
+        {
+            throw std::invalid_argument("Window size and slide must be positive");
+        }
+
+        return detail::time_window_type<TimeFunction, TimeType, OpType>(time, size, slide, op);
+    }
+
+    template
+    <
+        typename TimeFunction,
+        typename TimeType,
+        typename OpType
+    >
+    detail::time_window_type<TimeFunction, TimeType, OpType> time_window(const TimeFunction &time, const TimeType &size, const OpType &op)
+    {
+        return time_window(time, size, size, op);
+    }
+}
+
+#endif
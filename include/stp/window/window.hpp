@@ -0,0 +1,217 @@
+#ifndef STP_WINDOW_HPP
+#define STP_WINDOW_HPP
+
+#include <cstddef>
+#include <deque>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../accumulator.hpp"
+#include "../traits.hpp"
+#include "../num_reductions/max.hpp"
+#include "../num_reductions/min.hpp"
+
+namespace stp
+{
+    namespace detail
+    {
+        //Holds the last size elements pushed, and evaluates the reduction over them.
+        //Reductions without a reversible accumulator are recomputed over the whole window.
+        template
+        <
+            typename OpType,
+            typename ValueType,
+            typename Enable = void
+        >
+        class sliding_window
+        {
+            public:
+                using result_type = typename accumulator<OpType, ValueType>::result_type;
+
+                sliding_window(const OpType &op, const std::size_t &size) : op_(op), size_(size) {}
+
+                //Returns true once the window holds size elements
+                bool push(const ValueType &val)
+                {
+                    values_.push_back(val);
+                    if(values_.size() > size_)
+                    {
+                        values_.pop_front();
+                    }
+
+                    return values_.size() == size_;
+                }
+
+                result_type result() const
+                {
+                    accumulator<OpType, ValueType> acc(op_);
+                    for(const ValueType &i : values_)
+                    {
+                        acc.push(i);
+                    }
+
+                    return acc.result();
+                }
+
+            private:
+                OpType op_;
+                std::size_t size_;
+                std::deque<ValueType> values_;
+        };
+
+        //Invertible reductions add the new element and remove the oldest one in constant time
+        template
+        <
+            typename OpType,
+            typename ValueType
+        >
+        class sliding_window<OpType, ValueType, typename std::enable_if<reversible_accumulator<OpType, ValueType>::value>::type>
+        {
+            public:
+                using result_type = typename accumulator<OpType, ValueType>::result_type;
+
+                sliding_window(const OpType &op, const std::size_t &size) : acc_(op), size_(size) {}
+
+                bool push(const ValueType &val)
+                {
+                    values_.push_back(val);
+                    acc_.push(val);
+
+                    if(values_.size() > size_)
+                    {
+                        acc_.pop(values_.front());
+                        values_.pop_front();
+                    }
+
+                    return values_.size() == size_;
+                }
+
+                result_type result() const
+                {
+                    return acc_.result();
+                }
+
+            private:
+                reversible_accumulator<OpType, ValueType> acc_;
+                std::size_t size_;
+                std::deque<ValueType> values_;
+        };
+
+        //Keeps the elements which can still become the extreme of a later window, in order of
+        //arrival, so the extreme of the current window is always at the front. Each element is
+        //pushed and popped at most once.
+        template
+        <
+            typename ValueType,
+            typename Compare
+        >
+        class monotonic_window
+        {
+            public:
+                using result_type = ValueType;
+
+                monotonic_window(const std::size_t &size) : size_(size), count_(0) {}
+
+                bool push(const ValueType &val)
+                {
+                    while(!values_.empty() && !cmp_(values_.back().second, val))
+                    {
+                        values_.pop_back();
+                    }
+
+                    values_.push_back(std::make_pair(count_, val));
+                    ++count_;
+
+                    if(values_.front().first + size_ < count_)
+                    {
+                        values_.pop_front();
+                    }
+
+                    return count_ >= size_;
+                }
+
+                result_type result() const
+                {
+                    if(values_.empty())
+                    {
+                        throw std::range_error("Empty sequence");
+                    }
+
+                    return values_.front().second;
+                }
+
+            private:
+                Compare cmp_;
+                std::size_t size_;
+                std::size_t count_;
+                std::deque<std::pair<std::size_t, ValueType>> values_;
+        };
+
+        template <typename ValueType>
+        class sliding_window<min_type, ValueType> : public monotonic_window<ValueType, less_compare>
+        {
+            public:
+                sliding_window(const min_type &, const std::size_t &size) : monotonic_window<ValueType, less_compare>(size) {}
+        };
+
+        template <typename ValueType>
+        class sliding_window<max_type, ValueType> : public monotonic_window<ValueType, greater_compare>
+        {
+            public:
+                sliding_window(const max_type &, const std::size_t &size) : monotonic_window<ValueType, greater_compare>(size) {}
+        };
+
+        template <typename OpType>
+        struct window_type
+        {
+            window_type(const std::size_t &size, const OpType &op) : size_(size), op_(op) {}
+
+            template
+            <
+                typename SequenceType,
+                typename ValueType = typename SequenceType::value_type,
+                typename ResultType = typename sliding_window<OpType, ValueType>::result_type
+            >
+            std::vector<ResultType> operator()(const SequenceType &sequence) const
+            {
+                sliding_window<OpType, ValueType> window = state<ValueType>();
+
+                std::vector<ResultType> result;
+                for(const ValueType &i : sequence)
+                {
+                    if(window.push(i))
+                    {
+                        result.push_back(window.result());
+                    }
+                }
+
+                return result;
+            }
+
+            //Returns an empty window, for aggregating a stream one element at a time
+            template <typename ValueType>
+            sliding_window<OpType, ValueType> state() const
+            {
+                return sliding_window<OpType, ValueType>(op_, size_);
+            }
+
+            std::size_t size_;
+            OpType op_;
+        };
+    }
+
+    template <typename OpType>
+    detail::window_type<OpType> window(const std::size_t &size, const OpType &op)
+    {
+        if(size == 0)
+        {
+            throw std::invalid_argument("Window size must be positive");
+        }
+
+        return detail::window_type<OpType>(size, op);
+    }
+}
+
+#endif
@@ -1,14 +1,21 @@
 #define BOOST_TEST_MODULE STP_UT
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cctype>
 #include <chrono>
 #include <cmath>
+#include <cstdint>
+#include <deque>
 #include <limits>
+#include <list>
 #include <map>
+#include <numeric>
 #include <random>
 #include <stdexcept>
 #include <string>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -132,6 +139,38 @@ BOOST_FIXTURE_TEST_SUITE(bool_reduction_tests, test_fixture)
         BOOST_CHECK( equal_cv(char_vec)                           == true );
         BOOST_CHECK( equal_cv(std::vector<char>({'a', 'b', 'c'})) == false );
     }
+
+    BOOST_AUTO_TEST_CASE(equal_fast_path_test)
+    {
+        std::vector<int> large_ints = range(0, 1000);
+        std::vector<int> last_differs(large_ints);
+        std::vector<int> middle_differs(large_ints);
+        last_differs.back() = -1;
+        middle_differs[123] = -1;
+
+        std::deque<int> large_deque(large_ints.begin(), large_ints.end());
+        std::list<int> large_list(large_ints.begin(), large_ints.end());
+        std::array<int, 3> int_arr({{1, 2, 3}});
+
+        std::vector<double> zeros({0.0, 0.0, 1.0});
+        std::vector<double> negative_zeros({-0.0, -0.0, 1.0});
+
+        auto equal_large = equal(large_ints);
+        auto equal_list = equal(large_list);
+        auto equal_arr = equal(int_arr);
+        auto equal_zeros = equal(zeros);
+
+        BOOST_CHECK( equal_large(large_ints)                == true );
+        BOOST_CHECK( equal_large(last_differs)              == false );
+        BOOST_CHECK( equal_large(middle_differs)            == false );
+        BOOST_CHECK( equal_large(large_deque)               == true );
+        BOOST_CHECK( equal_large(large_list)                == true );
+        BOOST_CHECK( equal_list(large_ints)                 == true );
+        BOOST_CHECK( equal_list(middle_differs)             == false );
+        BOOST_CHECK( equal_arr(std::vector<int>({1, 2, 3})) == true );
+        BOOST_CHECK( equal_arr(std::vector<int>({1, 2, 4})) == false );
+        BOOST_CHECK( equal_zeros(negative_zeros)            == true );
+    }
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_FIXTURE_TEST_SUITE(filter_tests, test_fixture)
@@ -207,6 +246,22 @@ BOOST_FIXTURE_TEST_SUITE(filter_tests, test_fixture)
         BOOST_CHECK( take_lt5(empty_int_vec)   == empty_int_vec );
     }
 
+    BOOST_AUTO_TEST_CASE(par_where_test)
+    {
+        std::vector<int> large_ints = range(0, 100000);
+        std::list<int> int_list(ordered_ints.begin(), ordered_ints.end());
+
+        auto is_even = [](int i){return i % 2 == 0;};
+        auto par_even = where(par, is_even);
+        auto par_reverse_even = make_stp(reverse(), where(par, is_even));
+
+        BOOST_CHECK( par_even(large_ints)   == where(is_even)(large_ints) );
+        BOOST_CHECK( par_even(ordered_ints) == std::vector<int>({2, 4, 6, 8, 10}) );
+        BOOST_CHECK( par_even(int_list)     == std::list<int>({2, 4, 6, 8, 10}) );
+        BOOST_CHECK( par_even(empty_int_vec).empty() );
+        BOOST_CHECK( par_reverse_even(ordered_ints) == std::vector<int>({10, 8, 6, 4, 2}) );
+    }
+
     BOOST_AUTO_TEST_CASE(where_test)
     {
         auto where_not5 = where([](int i){return i != 5;});
@@ -230,6 +285,70 @@ BOOST_FIXTURE_TEST_SUITE(filter_tests, test_fixture)
         BOOST_CHECK( where_lt5(empty_int_vec)  == empty_int_vec );
 
     }
+
+    BOOST_AUTO_TEST_CASE(where_selection_test)
+    {
+        std::vector<int> large_ints = range(0, 1000);
+        std::deque<int> int_deque(ordered_ints.begin(), ordered_ints.end());
+        std::list<int> int_list(ordered_ints.begin(), ordered_ints.end());
+
+        int tested = 0;
+        auto even = where([](int i){return i % 2 == 0;});
+        auto counted_gt4 = where([&](int i){++tested; return i > 4;});
+        auto even_gt4 = make_stp(where([](int i){return i % 2 == 0;}), where([](int i){return i > 4;}));
+        auto chained_size = make_stp(where([](int i){return i % 3 == 0;}), where([](int i){return i % 5 == 0;}), size());
+        auto chained_sum = make_stp(where([](int i){return i % 3 == 0;}), where([](int i){return i % 5 == 0;}), sum());
+        auto even_sorted = make_stp(where([](int i){return i % 2 == 0;}), sort_with([](int a, int b){return a > b;}));
+
+        //Elements are marked rather than moved, and later filters only test the marked ones
+        BOOST_CHECK( even(ordered_ints).bitmap() == std::vector<std::uint64_t>({0x2aa}) );
+        BOOST_CHECK( even(ordered_ints).size() == 5 );
+        BOOST_CHECK( counted_gt4(even(ordered_ints)) == std::vector<int>({6, 8, 10}) );
+        BOOST_CHECK( tested == 5 );
+
+        BOOST_CHECK( even_gt4(ordered_ints)         == std::vector<int>({6, 8, 10}) );
+        BOOST_CHECK( even_gt4(int_deque)            == std::deque<int>({6, 8, 10}) );
+        BOOST_CHECK( even_gt4(int_list)             == std::list<int>({6, 8, 10}) );
+        BOOST_CHECK( even_gt4(range(1, 11))         == std::vector<int>({6, 8, 10}) );
+        BOOST_CHECK( chained_size(large_ints)       == 67 );
+        BOOST_CHECK( chained_sum(large_ints)        == 33165 );
+        BOOST_CHECK( even_sorted(ordered_ints)      == std::vector<int>({10, 8, 6, 4, 2}) );
+        BOOST_CHECK( even_gt4(empty_int_vec).empty() );
+
+        std::vector<int> gathered = even_gt4(ordered_ints);
+        BOOST_CHECK( gathered == std::vector<int>({6, 8, 10}) );
+
+        //A selection can be traversed backwards, and a transformation ending in where returns the container
+        auto multiples_reversed = make_stp(where([](int i){return i % 70 == 0;}), reverse(), to_vector());
+        auto even_batches = make_stp(where([](int i){return i % 2 == 0;}), batch(2), map([](const batch_of<std::vector<int>> &i){return sum()(i);}));
+        auto memo_even = memoize<std::vector<int>>(make_stp(where([](int i){return i % 2 == 0;})));
+        auto even_gt4_result = even_gt4(ordered_ints);
+        even_gt4_result.push_back(12);
+
+        BOOST_CHECK( multiples_reversed(large_ints) == std::vector<int>({980, 910, 840, 770, 700, 630, 560, 490, 420, 350, 280, 210, 140, 70, 0}) );
+        BOOST_CHECK( std::vector<int>(reverse()(even(ordered_ints))) == std::vector<int>({10, 8, 6, 4, 2}) );
+        BOOST_CHECK( even_batches(ordered_ints)     == std::vector<int>({6, 14, 10}) );
+        BOOST_CHECK( memo_even(ordered_ints, 1)     == std::vector<int>({2, 4, 6, 8, 10}) );
+        BOOST_CHECK( even_gt4_result                == std::vector<int>({6, 8, 10, 12}) );
+        BOOST_CHECK( even_gt4_result[0]             == 6 );
+
+        //Operations after where build the type of the filtered container
+        auto is_letter = [](char c){return c >= 'a' && c <= 'z';};
+        std::string letters_taken = make_stp(where(is_letter), take(2))(std::string("a1b2c3"));
+        std::string letters_sorted = make_stp(where(is_letter), sort())(std::string("c1a2b3"));
+        std::deque<int> deque_sorted = make_stp(where([](int i){return i % 2 == 0;}), sort_with([](int a, int b){return a > b;}))(int_deque);
+        std::deque<int> deque_unique = make_stp(where([](int i){return i < 4;}), unique())(std::deque<int>({1, 5, 1, 3, 3}));
+        std::list<int> list_dropped = make_stp(where([](int i){return i % 2 == 0;}), drop(3))(int_list);
+        std::list<int> list_taken = make_stp(where([](int i){return i % 2 == 0;}), take(2))(int_list);
+
+        BOOST_CHECK( letters_taken  == "ab" );
+        BOOST_CHECK( letters_sorted == "abc" );
+        BOOST_CHECK( deque_sorted   == std::deque<int>({10, 8, 6, 4, 2}) );
+        BOOST_CHECK( deque_unique   == std::deque<int>({1, 3}) );
+        BOOST_CHECK( list_dropped   == std::list<int>({8, 10}) );
+        BOOST_CHECK( list_taken     == std::list<int>({2, 4}) );
+    }
+
 BOOST_AUTO_TEST_SUITE_END() //filter_tests
 
 BOOST_FIXTURE_TEST_SUITE(generator_tests, test_fixture)
@@ -322,6 +441,137 @@ BOOST_FIXTURE_TEST_SUITE(generator_tests, test_fixture)
 BOOST_AUTO_TEST_SUITE_END() //generator_tests
 
 BOOST_FIXTURE_TEST_SUITE(misc_tests, test_fixture)
+    BOOST_AUTO_TEST_CASE(batch_test)
+    {
+        using int_batch = batch_of<std::vector<int>>;
+        using batches = std::vector<std::vector<int>>;
+
+        std::list<int> int_list(ordered_ints.begin(), ordered_ints.end());
+
+        auto batch_obj = batch(3);
+        auto batch_sums = make_stp(batch(3), map([](const int_batch &i){return sum()(i);}));
+        auto batch_sizes = make_stp(batch(4), map([](const int_batch &i){return i.size();}));
+        auto even_batches = make_stp(where([](int i){return i % 2 == 0;}), batch(2), to_vector());
+        auto first_batches = make_stp(batch(3), take(2));
+        auto list_batches = make_stp(batch(5), map([](const batch_of<std::list<int>> &i){return std::vector<int>(i);}));
+
+        //Batches refer to the input rather than copying it
+        BOOST_CHECK( &*(*batch_obj(ordered_ints).begin()).begin() == &ordered_ints[0] );
+        BOOST_CHECK( &*(*++batch_obj(ordered_ints).begin()).begin() == &ordered_ints[3] );
+
+        BOOST_CHECK( batch_obj(ordered_ints)        == batches({{1, 2, 3}, {4, 5, 6}, {7, 8, 9}, {10}}) );
+        BOOST_CHECK( batch_obj(ordered_ints).size() == 4 );
+        BOOST_CHECK( batch_sums(ordered_ints)       == std::vector<int>({6, 15, 24, 10}) );
+        BOOST_CHECK( batch_sizes(ordered_ints)      == std::vector<size_t>({4, 4, 2}) );
+        BOOST_CHECK( even_batches(ordered_ints)     == batches({{2, 4}, {6, 8}, {10}}) );
+        BOOST_CHECK( first_batches(ordered_ints)    == batches({{1, 2, 3}, {4, 5, 6}}) );
+        BOOST_CHECK( list_batches(int_list)         == batches({{1, 2, 3, 4, 5}, {6, 7, 8, 9, 10}}) );
+        BOOST_CHECK( batch_obj(empty_int_vec).empty() );
+
+        BOOST_CHECK_THROW( batch(0), std::invalid_argument );
+    }
+
+    BOOST_AUTO_TEST_CASE(bind_test)
+    {
+        int evaluations = 0;
+        auto counted_avg = make_stp(map([&](int i){++evaluations; return i;}), avg());
+
+        auto above_avg = make_stp(where(bind(counted_avg, [](double avg, int i){return i > avg;})), to_vector());
+        auto centered = map(bind(counted_avg, [](double avg, int i){return i - avg;}));
+        auto above_avg_reverse = make_stp(reverse(), where(bind(counted_avg, [](double avg, int i){return i > avg;})));
+        auto sum_above_avg = make_stp(where(bind(sum(), [](int total, int i){return i * 10 > total;})), sum());
+
+        BOOST_CHECK( above_avg(ordered_ints) == std::vector<int>({6, 7, 8, 9, 10}) );
+        BOOST_CHECK( evaluations == 10 );
+
+        evaluations = 0;
+        BOOST_CHECK( centered(ordered_ints) == std::vector<double>({-4.5, -3.5, -2.5, -1.5, -0.5, 0.5, 1.5, 2.5, 3.5, 4.5}) );
+        BOOST_CHECK( evaluations == 10 );
+
+        BOOST_CHECK( above_avg_reverse(ordered_ints) == std::vector<int>({10, 9, 8, 7, 6}) );
+        BOOST_CHECK( sum_above_avg(ordered_ints)     == 40 );
+        BOOST_CHECK( above_avg(std::vector<int>({3, 3, 3})).empty() );
+    }
+
+    BOOST_AUTO_TEST_CASE(columns_test)
+    {
+        using account_columns = columns<std::string, double, int>;
+
+        account_columns accts;
+        accts.push_back("Ben", 1550.4, 103);
+        accts.push_back("Mary", 240.0, 101);
+        accts.push_back("Eve", 1200.0, 104);
+        accts.push_back("Mark", 450.1, 102);
+
+        auto balances = make_stp(column<1>(), to_vector());
+        auto balance_sum = make_stp(column<1>(), sum());
+        auto rich_ids = make_stp(where_column<1>([](double i){return i > 1000.0;}), column<2>(), to_vector());
+        auto rich_m_names = make_stp(where_column<1>([](double i){return i > 400.0;}), where_column<0>([](const std::string &i){return i[0] == 'M';}), column<0>(), to_vector());
+        auto rich_count = make_stp(where_column<1>([](double i){return i > 1000.0;}), column<2>(), size());
+        auto sorted_ids = make_stp(column<2>(), sort());
+
+        //Columns are read in place rather than copied, so the vectorized reductions apply to them
+        BOOST_CHECK( column<1>()(accts).data() == accts.column<1>().data() );
+        static_assert(detail::has_simd_kernel<decltype(column<1>()(accts))>::value, "A column of arithmetic values must use the vectorized kernels");
+
+        std::vector<int> many_ids = range(0, 1000);
+        columns<int> id_columns(many_ids);
+        auto id_sum = make_stp(column<0>(), sum());
+        auto id_min = make_stp(column<0>(), min());
+        auto id_max = make_stp(column<0>(), max());
+
+        BOOST_CHECK( id_sum(id_columns)   == 499500 );
+        BOOST_CHECK( id_min(id_columns)   == 0 );
+        BOOST_CHECK( id_max(id_columns)   == 999 );
+
+        BOOST_CHECK( balances(accts)     == std::vector<double>({1550.4, 240.0, 1200.0, 450.1}) );
+        BOOST_CHECK( comp_real(balance_sum(accts), 3440.5, 1e-9) );
+        BOOST_CHECK( rich_ids(accts)     == std::vector<int>({103, 104}) );
+        BOOST_CHECK( rich_m_names(accts) == std::vector<std::string>({"Mark"}) );
+        BOOST_CHECK( rich_count(accts)   == 2 );
+        BOOST_CHECK( sorted_ids(accts)   == std::vector<int>({101, 102, 103, 104}) );
+        BOOST_CHECK( where_column<1>([](double i){return i > 1000.0;})(accts).rows() == std::vector<std::size_t>({0, 2}) );
+        BOOST_CHECK( rich_ids(account_columns({"Al"}, {2000.0}, {105})) == std::vector<int>({105}) );
+        BOOST_CHECK( rich_ids(account_columns()).empty() );
+
+        BOOST_CHECK_THROW( account_columns({"Al"}, {1.0, 2.0}, {105}), std::invalid_argument );
+    }
+
+    BOOST_AUTO_TEST_CASE(fixed_vector_test)
+    {
+        using small_ints = fixed_vector<int, 3>;
+        using ints_of_five = fixed_vector<int, 5>;
+
+        struct is_even
+        {
+            bool operator()(int i) const
+            {
+                return i % 2 == 0;
+            }
+        };
+
+        //Pipelines of stages without lambdas can be built at compile time
+        constexpr auto smallest_three = make_stp(sort(), take(3), to_fixed_vector<3>());
+        constexpr auto evens = make_stp(where(is_even()), to_fixed_vector<5>());
+        constexpr small_ints none;
+
+        static_assert(none.empty() && none.capacity() == 3, "fixed_vector must be usable in constant expressions");
+
+        const ints_of_five ints({5, 2, 4, 1, 3});
+        auto ints_sum = make_stp(sum());
+        auto big_ints = make_stp(where([](int i){return i > 2;}), to_vector());
+
+        BOOST_CHECK( smallest_three(unordered_ints) == small_ints({1, 2, 3}) );
+        BOOST_CHECK( evens(ordered_ints)            == ints_of_five({2, 4, 6, 8, 10}) );
+        BOOST_CHECK( ints_sum(ints)                 == 15 );
+        BOOST_CHECK( big_ints(ints)                 == std::vector<int>({5, 4, 3}) );
+        BOOST_CHECK( sort()(ints)                   == ints_of_five({1, 2, 3, 4, 5}) );
+        BOOST_CHECK( take(2)(ints_of_five(ints))    == ints_of_five({5, 2}) );
+
+        BOOST_CHECK_THROW( to_fixed_vector<3>()(ordered_ints), std::length_error );
+        BOOST_CHECK_THROW( small_ints({1, 2, 3, 4}), std::length_error );
+    }
+
     BOOST_AUTO_TEST_CASE(map_test)
     {
         auto map_str = map([](int i){return std::string("n", i);});
@@ -350,6 +600,20 @@ BOOST_FIXTURE_TEST_SUITE(misc_tests, test_fixture)
         BOOST_CHECK( map_vec(ordered_ints)     == map_vec_int );
     }
 
+    BOOST_AUTO_TEST_CASE(par_map_test)
+    {
+        std::vector<int> large_ints = range(0, 100000);
+        std::list<int> int_list(ordered_ints.begin(), ordered_ints.end());
+
+        auto par_square = map(par, [](int i){return static_cast<long long>(i) * i;});
+        auto par_odd = map(par, [](int i){return i % 2 == 1;});
+
+        BOOST_CHECK( par_square(large_ints)   == map([](int i){return static_cast<long long>(i) * i;})(large_ints) );
+        BOOST_CHECK( par_odd(large_ints)      == map([](int i){return i % 2 == 1;})(large_ints) );
+        BOOST_CHECK( par_square(int_list)     == std::vector<long long>({1, 4, 9, 16, 25, 36, 49, 64, 81, 100}) );
+        BOOST_CHECK( par_square(empty_int_vec).empty() );
+    }
+
     BOOST_AUTO_TEST_CASE(to_list_test)
     {
         auto tl_obj = to_list();
@@ -437,6 +701,29 @@ BOOST_FIXTURE_TEST_SUITE(misc_tests, test_fixture)
 BOOST_AUTO_TEST_SUITE_END() //misc_tests
 
 BOOST_FIXTURE_TEST_SUITE(num_reduction_tests, test_fixture)
+    BOOST_AUTO_TEST_CASE(approx_distinct_test)
+    {
+        auto distinct_obj = approx_distinct();
+        auto distinct_14 = approx_distinct(14);
+        std::vector<int> large_vec = range(0, 100000);
+        std::vector<int> first_half(large_vec.begin(), large_vec.begin() + 50000);
+        std::vector<int> second_half(large_vec.begin() + 40000, large_vec.end());
+
+        auto merged = distinct_14.sketch(first_half);
+        merged.merge(distinct_14.sketch(second_half));
+
+        BOOST_CHECK( std::round(distinct_obj(int_vec))       == 1.0 );
+        BOOST_CHECK( std::round(distinct_obj(ordered_ints))  == 10.0 );
+        BOOST_CHECK( std::round(distinct_obj(string_vec))    == 5.0 );
+        BOOST_CHECK( distinct_obj(empty_int_vec)             == 0.0 );
+        BOOST_CHECK( std::fabs(distinct_14(large_vec) - 100000.0) < 100000.0 * 3 * merged.relative_error() );
+        BOOST_CHECK( merged.estimate()                       == distinct_14(large_vec) );
+        BOOST_CHECK_THROW( approx_distinct(3), std::invalid_argument );
+        BOOST_CHECK_THROW( approx_distinct(64), std::invalid_argument );
+        BOOST_CHECK_THROW( detail::hll_sketch(40), std::invalid_argument );
+        BOOST_CHECK_THROW( merged.merge(distinct_obj.sketch(int_vec)), std::invalid_argument );
+    }
+
     BOOST_AUTO_TEST_CASE(avg_test)
     {
         auto avg_obj = avg();
@@ -506,6 +793,114 @@ BOOST_FIXTURE_TEST_SUITE(num_reduction_tests, test_fixture)
         BOOST_CHECK_THROW( min_obj(empty_int_vec), std::range_error );
     }
 
+    BOOST_AUTO_TEST_CASE(quantile_test)
+    {
+        std::vector<int> large_vec = range(0, 10001);
+        std::shuffle(large_vec.begin(), large_vec.end(), std::default_random_engine(42));
+        std::vector<int> first_half(large_vec.begin(), large_vec.begin() + 5000);
+        std::vector<int> second_half(large_vec.begin() + 5000, large_vec.end());
+
+        auto median_obj = approx_quantile(0.5);
+        auto approx_obj = quantiles({0.0, 0.5, 0.99, 1.0});
+        auto exact_obj = quantiles({0.99, 0.5, 0.25}, exact);
+
+        auto merged = median_obj.sketch(first_half);
+        merged.merge(median_obj.sketch(second_half));
+
+        std::vector<double> approx_result = approx_obj(large_vec);
+
+        BOOST_CHECK( std::fabs(median_obj(large_vec) - 5000.0) < 50.0 );
+        BOOST_CHECK( std::fabs(merged.quantile(0.5) - 5000.0)  < 50.0 );
+        BOOST_CHECK( merged.centroid_count()                   < 1000 );
+        BOOST_CHECK( approx_result[0]                          == 0.0 );
+        BOOST_CHECK( std::fabs(approx_result[2] - 9900.0)      < 20.0 );
+        BOOST_CHECK( approx_result[3]                          == 10000.0 );
+        BOOST_CHECK( exact_obj(large_vec)                      == std::vector<double>({9900.0, 5000.0, 2500.0}) );
+        BOOST_CHECK( exact_obj(unordered_ints)                 == std::vector<double>({9.91, 5.5, 3.25}) );
+        BOOST_CHECK( median_obj(int_vec)                       == 5.0 );
+        BOOST_CHECK( comp_real(median_obj(float_vec), 5.1, 0.0001) );
+        BOOST_CHECK_THROW( median_obj(empty_int_vec), std::range_error );
+        BOOST_CHECK_THROW( exact_obj(empty_int_vec), std::range_error );
+        BOOST_CHECK_THROW( approx_quantile(1.5), std::invalid_argument );
+
+        //Reading a digest whose values are still buffered leaves it unchanged, so it can be shared between threads
+        const auto buffered = median_obj.sketch(ordered_ints);
+        std::vector<double> medians(8);
+        detail::parallel_for(medians.size(), [&](const std::size_t &i){medians[i] = buffered.quantile(0.5);});
+
+        auto flushed = buffered;
+        flushed.compress();
+
+        BOOST_CHECK( medians                                   == std::vector<double>(8, flushed.quantile(0.5)) );
+        BOOST_CHECK( buffered.centroid_count()                 == flushed.centroid_count() );
+    }
+
+    BOOST_AUTO_TEST_CASE(reduce_all_test)
+    {
+        auto sum_max_count = reduce_all(sum(), max(), count(5));
+        auto fold_any_size = reduce_all(fold(std::minus<int>(), 0), any([](const int &i){return i > 9;}), size(), contains(3));
+        auto min_all = reduce_all(min(), all([](const std::string &i){return i[0] == 's';}));
+
+        BOOST_CHECK( sum_max_count(ordered_ints)  == std::make_tuple(55, 10, 1) );
+        BOOST_CHECK( sum_max_count(int_vec)       == std::make_tuple(25, 5, 5) );
+        BOOST_CHECK( fold_any_size(ordered_ints)  == std::make_tuple(-55, true, 10, true) );
+        BOOST_CHECK( fold_any_size(empty_int_vec) == std::make_tuple(0, false, 0, false) );
+        BOOST_CHECK( min_all(std::list<std::string>(string_vec.begin(), string_vec.end())) == std::make_tuple(std::string("s1 "), true) );
+        BOOST_CHECK( comp_real(std::get<0>(reduce_all(avg())(std::list<int>({1, 2, 4}))), 7.0 / 3.0, 1e-12) );
+        BOOST_CHECK_THROW( sum_max_count(empty_int_vec), std::range_error );
+
+        auto distinct_sum = reduce_all(approx_distinct(), sum());
+        BOOST_CHECK( std::round(std::get<0>(distinct_sum(unordered_ints))) == 10.0 );
+
+        auto quantile_sketches = reduce_all(quantiles({0.0, 0.5, 1.0}, exact), approx_quantile(1.0));
+        BOOST_CHECK( std::get<0>(quantile_sketches(unordered_ints))          == std::vector<double>({1.0, 5.5, 10.0}) );
+        BOOST_CHECK( std::get<1>(quantile_sketches(unordered_ints))          == 10.0 );
+        BOOST_CHECK( std::get<0>(reduce_all(quantiles({0.5}))(ordered_ints)) == quantiles({0.5})(ordered_ints) );
+
+        auto ranked = reduce_all(top_k(3), bottom_k_by(2, [](int i){return i % 4;}))(unordered_ints);
+        BOOST_CHECK( std::get<0>(ranked) == std::vector<int>({10, 9, 8}) );
+        BOOST_CHECK( std::get<1>(ranked) == bottom_k_by(2, [](int i){return i % 4;})(unordered_ints) );
+    }
+
+    BOOST_AUTO_TEST_CASE(simd_kernel_test)
+    {
+        std::default_random_engine engine(7);
+        std::uniform_int_distribution<int> int_dist(-1000, 1000);
+        std::uniform_real_distribution<double> real_dist(-1000.0, 1000.0);
+
+        std::vector<int> large_ints(1037);
+        std::vector<double> large_doubles(1037);
+        std::vector<float> large_floats(1037);
+        for(size_t i = 0; i < large_ints.size(); ++i)
+        {
+            large_ints[i] = int_dist(engine);
+            large_doubles[i] = real_dist(engine);
+            large_floats[i] = static_cast<float>(large_doubles[i]);
+        }
+        std::array<int, 40> int_array;
+        std::copy(large_ints.begin(), large_ints.begin() + 40, int_array.begin());
+
+        auto sum_obj = sum();
+        auto min_obj = min();
+        auto max_obj = max();
+        auto count_3 = count(3);
+        double double_sum = std::accumulate(large_doubles.begin(), large_doubles.end(), 0.0);
+        float float_sum = std::accumulate(large_floats.begin(), large_floats.end(), 0.0f);
+
+        BOOST_CHECK( sum_obj(large_ints)                         == std::accumulate(large_ints.begin(), large_ints.end(), 0) );
+        BOOST_CHECK( sum_obj(int_array)                          == std::accumulate(int_array.begin(), int_array.end(), 0) );
+        BOOST_CHECK( comp_real(sum_obj(large_doubles), double_sum, 1e-9) );
+        BOOST_CHECK( comp_real(sum_obj(large_floats), float_sum, 0.5f) );
+        BOOST_CHECK( min_obj(large_ints)                         == *std::min_element(large_ints.begin(), large_ints.end()) );
+        BOOST_CHECK( min_obj(large_doubles)                      == *std::min_element(large_doubles.begin(), large_doubles.end()) );
+        BOOST_CHECK( min_obj(int_array)                          == *std::min_element(int_array.begin(), int_array.end()) );
+        BOOST_CHECK( max_obj(large_ints)                         == *std::max_element(large_ints.begin(), large_ints.end()) );
+        BOOST_CHECK( max_obj(large_floats)                       == *std::max_element(large_floats.begin(), large_floats.end()) );
+        BOOST_CHECK( count_3(large_ints)                         == std::count(large_ints.begin(), large_ints.end(), 3) );
+        BOOST_CHECK( count(3.0)(std::vector<double>(100, 3.0))   == 100 );
+        BOOST_CHECK( count(3.5)(std::vector<int>(100, 3))        == 0 );
+    }
+
     BOOST_AUTO_TEST_CASE(size_test)
     {
         auto size_obj = size();
@@ -519,6 +914,67 @@ BOOST_FIXTURE_TEST_SUITE(num_reduction_tests, test_fixture)
         BOOST_CHECK( size_obj(empty_int_vec)  == 0 );
     }
 
+    BOOST_AUTO_TEST_CASE(stats_test)
+    {
+        auto stats_obj = stats();
+        auto oi_stats = stats_obj(unordered_ints);
+        auto fv_stats = stats_obj(float_vec);
+        auto list_stats = stats_obj(std::list<double>({2.0, 4.0, 4.0, 4.0, 5.0, 5.0, 7.0, 9.0}));
+
+        BOOST_CHECK( oi_stats.count == 10 );
+        BOOST_CHECK( oi_stats.min   == 1 );
+        BOOST_CHECK( oi_stats.max   == 10 );
+        BOOST_CHECK( comp_real(oi_stats.sum, 55.0, 1e-12) );
+        BOOST_CHECK( comp_real(oi_stats.mean, 5.5, 1e-12) );
+        BOOST_CHECK( comp_real(oi_stats.variance, 8.25, 1e-12) );
+        BOOST_CHECK( comp_real(fv_stats.variance, 0.0, 1e-9) );
+        BOOST_CHECK( fv_stats.max   == 5.1f );
+        BOOST_CHECK( comp_real(list_stats.mean, 5.0, 1e-12) );
+        BOOST_CHECK( comp_real(list_stats.variance, 4.0, 1e-12) );
+        BOOST_CHECK_THROW( stats_obj(empty_int_vec), std::range_error );
+    }
+
+    BOOST_AUTO_TEST_CASE(par_reduce_test)
+    {
+        std::vector<int> large_ints = range(0, 100000);
+        std::shuffle(large_ints.begin(), large_ints.end(), std::default_random_engine(17));
+        std::list<int> int_list(ordered_ints.begin(), ordered_ints.end());
+
+        auto par_stats = reduce(par, stats());
+        auto par_distinct = reduce(par, approx_distinct());
+        auto par_median = reduce(par, approx_quantile(0.5));
+        auto par_top = reduce(par, top_k(3));
+        auto par_sum = reduce(par, sum());
+
+        BOOST_CHECK( par_stats(large_ints).count              == 100000 );
+        BOOST_CHECK( comp_real(par_stats(large_ints).variance, stats()(large_ints).variance, 1e-9) );
+        BOOST_CHECK( std::fabs(par_distinct(large_ints) - 100000.0) < 3000.0 );
+        BOOST_CHECK( std::fabs(par_median(large_ints) - 50000.0)    < 500.0 );
+        BOOST_CHECK( par_top(large_ints)                      == std::vector<int>({99999, 99998, 99997}) );
+        BOOST_CHECK( par_top(int_list)                        == std::vector<int>({10, 9, 8}) );
+        BOOST_CHECK( par_sum(ordered_ints)                    == 55 );
+        BOOST_CHECK_THROW( par_stats(empty_int_vec), std::range_error );
+
+        //Merging accumulators of two halves gives the result of one accumulator over both
+        detail::mergeable_accumulator<detail::stats_type, int> first(stats()), second(stats());
+        detail::mergeable_accumulator<detail::top_k_type<detail::less_compare>, int> first_top(top_k(2)), second_top(top_k(2));
+        for(size_t i = 0; i < unordered_ints.size(); ++i)
+        {
+            (i < 3 ? first : second).push(unordered_ints[i]);
+            (i < 3 ? first_top : second_top).push(unordered_ints[i]);
+        }
+
+        first.merge(second);
+        first_top.merge(second_top);
+
+        BOOST_CHECK( first.result().count == 10 );
+        BOOST_CHECK( first.result().min   == 1 );
+        BOOST_CHECK( first.result().max   == 10 );
+        BOOST_CHECK( comp_real(first.result().mean, 5.5, 1e-12) );
+        BOOST_CHECK( comp_real(first.result().variance, 8.25, 1e-12) );
+        BOOST_CHECK( first_top.result()   == std::vector<int>({10, 9}) );
+    }
+
     BOOST_AUTO_TEST_CASE(sum_test)
     {
         auto sum_obj = sum();
@@ -543,6 +999,53 @@ BOOST_FIXTURE_TEST_SUITE(order_tests, test_fixture)
         BOOST_CHECK( reverse_obj(empty_int_vec) == empty_int_vec );
     }
 
+    BOOST_AUTO_TEST_CASE(reverse_view_test)
+    {
+        std::vector<int> reversed_ints({10, 9, 8, 7, 6, 5, 4, 3, 2, 1});
+
+        auto reverse_obj = reverse();
+        auto reverse_take = make_stp(reverse(), take(3));
+        auto reverse_drop = make_stp(reverse(), drop(8));
+        auto reverse_where = make_stp(reverse(), where([](int i){return i % 2 == 0;}));
+        auto reverse_while = make_stp(reverse(), take_while([](int i){return i > 7;}));
+        auto reverse_sum = make_stp(reverse(), sum());
+        auto reverse_unique = make_stp(reverse(), unique());
+        auto double_reverse = make_stp(reverse(), reverse(), to_vector());
+        auto map_reverse = make_stp(map([](int i){return i * 2;}), reverse());
+
+        //An lvalue is referenced rather than copied
+        BOOST_CHECK( &*reverse_obj(ordered_ints).begin() == &ordered_ints.back() );
+        BOOST_CHECK( reverse_obj(ordered_ints).size()    == 10 );
+
+        std::vector<int> converted = reverse_obj(ordered_ints);
+        std::vector<int> from_temporary = reverse_obj(std::vector<int>({1, 2, 3}));
+
+        BOOST_CHECK( converted                            == reversed_ints );
+        BOOST_CHECK( from_temporary                       == std::vector<int>({3, 2, 1}) );
+        BOOST_CHECK( reverse_take(ordered_ints)           == std::vector<int>({10, 9, 8}) );
+        BOOST_CHECK( reverse_drop(ordered_ints)           == std::vector<int>({2, 1}) );
+        BOOST_CHECK( reverse_where(ordered_ints)          == std::vector<int>({10, 8, 6, 4, 2}) );
+        BOOST_CHECK( reverse_while(ordered_ints)          == std::vector<int>({10, 9, 8}) );
+        BOOST_CHECK( reverse_sum(ordered_ints)            == 55 );
+        BOOST_CHECK( reverse_unique(int_vec)              == std::vector<int>({5}) );
+        BOOST_CHECK( double_reverse(ordered_ints)         == ordered_ints );
+        BOOST_CHECK( map_reverse(ordered_ints)            == std::vector<int>({20, 18, 16, 14, 12, 10, 8, 6, 4, 2}) );
+        BOOST_CHECK( reverse_obj(ordered_ints)            != ordered_ints );
+        BOOST_CHECK( reverse_obj(empty_int_vec).empty() );
+
+        //Operations after reverse build the type of the reversed container
+        std::list<int> int_list(ordered_ints.begin(), ordered_ints.end());
+        std::list<int> list_where = reverse_where(int_list);
+        std::list<int> list_take = reverse_take(int_list);
+        std::deque<int> deque_drop = reverse_drop(std::deque<int>(ordered_ints.begin(), ordered_ints.end()));
+        std::string string_unique = make_stp(reverse(), unique())(std::string("abcab"));
+
+        BOOST_CHECK( list_where    == std::list<int>({10, 8, 6, 4, 2}) );
+        BOOST_CHECK( list_take     == std::list<int>({10, 9, 8}) );
+        BOOST_CHECK( deque_drop    == std::deque<int>({2, 1}) );
+        BOOST_CHECK( string_unique == "bac" );
+    }
+
     BOOST_AUTO_TEST_CASE(sort_test)
     {
         auto sort_obj = sort();
@@ -557,6 +1060,267 @@ BOOST_FIXTURE_TEST_SUITE(order_tests, test_fixture)
         BOOST_CHECK( sort_obj(reverse_obj(ordered_ints)) == ordered_ints );
     }
 
+    BOOST_AUTO_TEST_CASE(external_sort_test)
+    {
+        std::vector<int> large_ints = range(0, 10000);
+        std::shuffle(large_ints.begin(), large_ints.end(), std::default_random_engine(5));
+
+        auto spill_sort = external_sort(64 * sizeof(int), ".");
+        auto memory_sort = external_sort(1 << 20, ".");
+        auto spill_sum = make_stp(external_sort(100 * sizeof(int), "."), sum());
+        auto tv_obj = to_vector();
+
+        BOOST_CHECK( tv_obj(spill_sort(large_ints))                        == range(0, 10000) );
+        BOOST_CHECK( tv_obj(spill_sort(unordered_ints))                    == ordered_ints );
+        BOOST_CHECK( tv_obj(spill_sort(std::list<int>({3, 1, 2})))         == std::vector<int>({1, 2, 3}) );
+        BOOST_CHECK( tv_obj(memory_sort(large_ints))                       == range(0, 10000) );
+        BOOST_CHECK( tv_obj(spill_sort(empty_int_vec))                     == empty_int_vec );
+        BOOST_CHECK( tv_obj(external_sort(0, ".")(unordered_ints))         == ordered_ints );
+        BOOST_CHECK( spill_sum(large_ints)                                 == 49995000 );
+
+        //The result can be traversed more than once, and operations which need more than that copy it
+        auto spill_doubled = make_stp(external_sort(4 * sizeof(int), "."), map([](int i){return i * 2;}));
+        auto spill_evens = make_stp(external_sort(4 * sizeof(int), "."), where([](int i){return i % 2 == 0;}));
+        auto spill_first = make_stp(external_sort(4 * sizeof(int), "."), take(3));
+        auto spill_reverse = make_stp(external_sort(4 * sizeof(int), "."), reverse(), to_vector());
+        auto spill_zip = make_stp(external_sort(4 * sizeof(int), "."), zip(range(0, 10)), to_vector());
+        auto sorted = spill_sort(unordered_ints);
+
+        BOOST_CHECK( tv_obj(sorted)                                        == ordered_ints );
+        BOOST_CHECK( tv_obj(sorted)                                        == ordered_ints );
+        BOOST_CHECK( spill_doubled(unordered_ints)                         == std::vector<int>({2, 4, 6, 8, 10, 12, 14, 16, 18, 20}) );
+        BOOST_CHECK( spill_evens(unordered_ints)                           == std::vector<int>({2, 4, 6, 8, 10}) );
+        BOOST_CHECK( spill_first(unordered_ints)                           == std::vector<int>({1, 2, 3}) );
+        BOOST_CHECK( spill_reverse(unordered_ints)                         == range(10, 0) );
+        BOOST_CHECK( spill_zip(unordered_ints)[9]                          == std::make_pair(10, 9) );
+        BOOST_CHECK( equal(ordered_ints)(sorted) );
+        BOOST_CHECK( !equal(std::vector<int>(10, 0))(sorted) );
+        BOOST_CHECK( !equal(std::vector<int>({1, 2, 3, 4, 5, 6, 7, 8, 9, 9}))(sorted) );
+        BOOST_CHECK( size()(sorted)                                        == 10 );
+        BOOST_CHECK_THROW( external_sort(sizeof(int), "/nonexistent/dir")(ordered_ints), std::runtime_error );
+    }
+
+    BOOST_AUTO_TEST_CASE(radix_sort_test)
+    {
+        std::default_random_engine engine(11);
+        std::uniform_int_distribution<int> int_dist(std::numeric_limits<int>::min(), std::numeric_limits<int>::max());
+        std::uniform_real_distribution<double> real_dist(-1e6, 1e6);
+
+        std::vector<int> large_ints(5000);
+        std::vector<unsigned char> large_chars(5000);
+        std::vector<double> large_doubles(5000);
+        std::vector<float> large_floats(5000);
+        for(size_t i = 0; i < large_ints.size(); ++i)
+        {
+            large_ints[i] = int_dist(engine);
+            large_chars[i] = static_cast<unsigned char>(large_ints[i]);
+            large_doubles[i] = real_dist(engine);
+            large_floats[i] = static_cast<float>(large_doubles[i]);
+        }
+        large_doubles[0] = -0.0;
+        large_doubles[1] = std::numeric_limits<double>::infinity();
+        large_doubles[2] = -std::numeric_limits<double>::infinity();
+
+        auto sort_obj = sort();
+        std::vector<int> sorted_ints(large_ints);
+        std::vector<unsigned char> sorted_chars(large_chars);
+        std::vector<double> sorted_doubles(large_doubles);
+        std::vector<float> sorted_floats(large_floats);
+        std::sort(sorted_ints.begin(), sorted_ints.end());
+        std::sort(sorted_chars.begin(), sorted_chars.end());
+        std::sort(sorted_doubles.begin(), sorted_doubles.end());
+        std::sort(sorted_floats.begin(), sorted_floats.end());
+
+        BOOST_CHECK( sort_obj(large_ints)    == sorted_ints );
+        BOOST_CHECK( sort_obj(large_chars)   == sorted_chars );
+        BOOST_CHECK( sort_obj(large_doubles) == sorted_doubles );
+        BOOST_CHECK( sort_obj(large_floats)  == sorted_floats );
+    }
+
+    BOOST_AUTO_TEST_CASE(adaptive_sort_test)
+    {
+        std::default_random_engine engine(19);
+        std::uniform_int_distribution<int> int_dist(0, 1000);
+
+        std::vector<int> random_ints(10000);
+        for(size_t i = 0; i < random_ints.size(); ++i)
+        {
+            random_ints[i] = int_dist(engine);
+        }
+
+        std::vector<int> sorted_ints(random_ints);
+        std::sort(sorted_ints.begin(), sorted_ints.end());
+
+        std::vector<int> desc_ints(sorted_ints.rbegin(), sorted_ints.rend());
+
+        std::vector<int> chunked_ints(random_ints);
+        for(size_t i = 0; i < chunked_ints.size(); i += 1000)
+        {
+            std::sort(chunked_ints.begin() + i, chunked_ints.begin() + i + 1000);
+            if(i % 2000 == 0)
+            {
+                std::reverse(chunked_ints.begin() + i, chunked_ints.begin() + i + 1000);
+            }
+        }
+
+        std::vector<int> outlier_ints(sorted_ints);
+        std::vector<int> local_ints(sorted_ints);
+        for(size_t i = 0; i < 200; ++i)
+        {
+            std::swap(outlier_ints[engine() % outlier_ints.size()], outlier_ints[engine() % outlier_ints.size()]);
+            size_t j = engine() % (local_ints.size() - 20);
+            std::swap(local_ints[j], local_ints[j + engine() % 20]);
+        }
+
+        std::vector<int> many_outliers(sorted_ints);
+        for(size_t i = 0; i < many_outliers.size(); i += 40)
+        {
+            many_outliers[i] = int_dist(engine);
+        }
+
+        std::vector<int> expected_many(many_outliers);
+        std::sort(expected_many.begin(), expected_many.end());
+
+        std::vector<std::string> outlier_strs;
+        for(size_t i = 0; i < outlier_ints.size(); ++i)
+        {
+            outlier_strs.push_back(std::to_string(100000 + outlier_ints[i]));
+        }
+
+        std::vector<std::string> sorted_strs(outlier_strs);
+        std::sort(sorted_strs.begin(), sorted_strs.end());
+
+        auto sort_obj = sort();
+        auto sort_with_obj = sort_with([](int a, int b){return a > b;});
+
+        BOOST_CHECK( sort_obj(sorted_ints)       == sorted_ints );
+        BOOST_CHECK( sort_obj(desc_ints)         == sorted_ints );
+        BOOST_CHECK( sort_obj(chunked_ints)      == sorted_ints );
+        BOOST_CHECK( sort_obj(outlier_ints)      == sorted_ints );
+        BOOST_CHECK( sort_obj(local_ints)        == sorted_ints );
+        BOOST_CHECK( sort_obj(many_outliers)     == expected_many );
+        BOOST_CHECK( sort_obj(outlier_strs)      == sorted_strs );
+        BOOST_CHECK( sort_with_obj(sorted_ints)  == desc_ints );
+        BOOST_CHECK( sort_with_obj(outlier_ints) == desc_ints );
+        BOOST_CHECK( sort_with_obj(chunked_ints) == desc_ints );
+    }
+
+    BOOST_AUTO_TEST_CASE(string_sort_test)
+    {
+        std::default_random_engine engine(17);
+        std::uniform_int_distribution<int> len_dist(0, 24);
+        std::uniform_int_distribution<int> char_dist(0, 3);
+        const std::string alphabet("a\0\xff", 3);
+        const std::string common_prefix("common_prefix_longer_than_eight_bytes/");
+
+        std::vector<std::string> large_strs(5000);
+        for(size_t i = 0; i < large_strs.size(); ++i)
+        {
+            std::string str = (i % 3 == 0) ? common_prefix : "";
+            int len = len_dist(engine);
+            for(int j = 0; j < len; ++j)
+            {
+                int c = char_dist(engine);
+                str += (c == 3) ? static_cast<char>('a' + j % 26) : alphabet[c];
+            }
+            large_strs[i] = str;
+        }
+
+        std::vector<std::string> sorted_strs(large_strs);
+        std::sort(sorted_strs.begin(), sorted_strs.end());
+
+        std::array<std::string, 3> small_arr({{"b", "", "a"}});
+        std::array<std::string, 3> sorted_arr({{"", "a", "b"}});
+
+        auto sort_obj = sort();
+
+        BOOST_CHECK( sort_obj(large_strs) == sorted_strs );
+        BOOST_CHECK( sort_obj(small_arr)  == sorted_arr );
+    }
+
+    BOOST_AUTO_TEST_CASE(par_sort_test)
+    {
+        std::default_random_engine engine(13);
+        std::uniform_int_distribution<int> int_dist(-1000000, 1000000);
+
+        std::vector<int> large_ints(200000);
+        std::vector<std::string> large_strs(50000);
+        for(size_t i = 0; i < large_ints.size(); ++i)
+        {
+            large_ints[i] = int_dist(engine);
+        }
+        for(size_t i = 0; i < large_strs.size(); ++i)
+        {
+            large_strs[i] = std::to_string(int_dist(engine) % 1000);
+        }
+
+        std::vector<int> sorted_ints(large_ints);
+        std::vector<int> desc_ints(large_ints);
+        std::vector<std::string> sorted_strs(large_strs);
+        std::sort(sorted_ints.begin(), sorted_ints.end());
+        std::sort(desc_ints.begin(), desc_ints.end(), [](int a, int b){return a > b;});
+        std::sort(sorted_strs.begin(), sorted_strs.end());
+
+        std::vector<int> small_ints({4, 2, 1, 3});
+        std::vector<int> small_sorted({1, 2, 3, 4});
+        std::deque<int> large_deque(large_ints.begin(), large_ints.end());
+        std::deque<int> sorted_deque(sorted_ints.begin(), sorted_ints.end());
+
+        auto sort_obj = sort(par);
+        auto sort_with_obj = sort_with(par, [](int a, int b){return a > b;});
+        auto sort_str_obj = sort_with(par, [](std::string a, std::string b){return a < b;});
+        auto throw_obj = sort_with(par, [](int a, int b) -> bool {if(a == b){throw std::runtime_error("equal");} return a < b;});
+
+        BOOST_CHECK( sort_obj(large_ints)      == sorted_ints );
+        BOOST_CHECK( sort_obj(small_ints)      == small_sorted );
+        BOOST_CHECK( sort_obj(large_deque)     == sorted_deque );
+        BOOST_CHECK( sort_obj(large_strs)      == sorted_strs );
+        BOOST_CHECK( sort_with_obj(large_ints) == desc_ints );
+        BOOST_CHECK( sort_str_obj(large_strs)  == sorted_strs );
+
+        BOOST_CHECK_THROW( throw_obj(std::vector<int>(100000, 1)), std::runtime_error );
+
+        //Force the threaded path regardless of the number of cores on the test machine
+        std::vector<int> forced_ints(large_ints);
+        std::vector<std::string> forced_strs(large_strs);
+        detail::parallel_sort(forced_ints.begin(), forced_ints.end(), detail::less_compare(), detail::method_sorter<detail::radix_sort_method>(), 5);
+        detail::parallel_sort(forced_strs.begin(), forced_strs.end(), detail::less_compare(), detail::method_sorter<detail::string_sort_method>(), 3);
+
+        BOOST_CHECK( forced_ints == sorted_ints );
+        BOOST_CHECK( forced_strs == sorted_strs );
+    }
+
+    BOOST_AUTO_TEST_CASE(sort_by_test)
+    {
+        int key_calls = 0;
+        auto sort_by_neg = sort_by([&](int i){++key_calls; return -i;});
+        auto sort_by_len = sort_by([](const std::string &i){return i.size();});
+        auto sort_by_str = sort_by([](const std::pair<int, std::string> &i){return i.second;});
+        auto reverse_obj = reverse();
+
+        std::vector<int> large_ints = range(0, 1000);
+        std::shuffle(large_ints.begin(), large_ints.end(), std::default_random_engine(3));
+        std::vector<std::pair<int, std::string>> pairs({std::make_pair(1, std::string("b")), std::make_pair(2, std::string("a")), std::make_pair(3, std::string("b")), std::make_pair(4, std::string("a"))});
+
+        BOOST_CHECK( sort_by_neg(unordered_ints)            == reverse_obj(ordered_ints) );
+        BOOST_CHECK( key_calls                              == 10 );
+        BOOST_CHECK( sort_by_neg(large_ints)                == range(999, -1) );
+        BOOST_CHECK( sort_by_neg(empty_int_vec)             == empty_int_vec );
+        BOOST_CHECK( sort_by_len(reverse_obj(string_vec))   == string_vec );
+        BOOST_CHECK( (sort_by_str(pairs)                   == std::vector<std::pair<int, std::string>>({pairs[1], pairs[3], pairs[0], pairs[2]})) );
+        BOOST_CHECK( sort_by_neg(std::list<int>({2, 3, 1})) == std::list<int>({3, 2, 1}) );
+
+        //Above the radix threshold the keys are radix sorted, which must stay stable
+        std::vector<int> radix_ints = range(0, 5000);
+        std::vector<int> by_parity = sort_by([](int i){return i % 2;})(radix_ints);
+        std::shuffle(radix_ints.begin(), radix_ints.end(), std::default_random_engine(5));
+
+        BOOST_CHECK( sort_by_neg(radix_ints)                == range(4999, -1) );
+        BOOST_CHECK( std::is_sorted(by_parity.begin(), by_parity.begin() + 2500) );
+        BOOST_CHECK( std::is_sorted(by_parity.begin() + 2500, by_parity.end()) );
+        BOOST_CHECK( by_parity[2500]                        == 1 );
+    }
+
     BOOST_AUTO_TEST_CASE(sort_with_test)
     {
         auto sort_with_int_comp = sort_with([](int i, int j){return i < j;});
@@ -570,6 +1334,28 @@ BOOST_FIXTURE_TEST_SUITE(order_tests, test_fixture)
         BOOST_CHECK( sort_with_str_comp(string_vec)                == string_vec );
         BOOST_CHECK( sort_with_str_comp(reverse_obj(string_vec))   == string_vec );
     }
+
+    BOOST_AUTO_TEST_CASE(top_k_test)
+    {
+        auto top_3 = top_k(3);
+        auto top_0 = top_k(0);
+        auto bottom_3 = bottom_k(3);
+        auto top_3_len = top_k(3, [](const std::string &i, const std::string &j){return i.size() < j.size();});
+        auto top_2_by = top_k_by(2, [](int i){return -i;});
+        auto bottom_2_by = bottom_k_by(2, [](const std::string &i){return i.size();});
+
+        BOOST_CHECK( top_3(unordered_ints)                 == std::vector<int>({10, 9, 8}) );
+        BOOST_CHECK( top_3(int_vec)                        == std::vector<int>({5, 5, 5}) );
+        BOOST_CHECK( top_3(std::vector<int>({2, 1}))       == std::vector<int>({2, 1}) );
+        BOOST_CHECK( top_3(empty_int_vec)                  == empty_int_vec );
+        BOOST_CHECK( top_0(unordered_ints)                 == empty_int_vec );
+        BOOST_CHECK( bottom_3(unordered_ints)              == std::vector<int>({1, 2, 3}) );
+        BOOST_CHECK( top_3_len(string_vec)                 == std::vector<std::string>({"s5     ", "s4    ", "s3   "}) );
+        BOOST_CHECK( top_2_by(unordered_ints)              == std::vector<int>({1, 2}) );
+        BOOST_CHECK( bottom_2_by(string_vec)               == std::vector<std::string>({"s1 ", "s2  "}) );
+        BOOST_CHECK( top_3.merge(top_3(std::vector<int>({1, 7, 3})), top_3(std::vector<int>({9, 2}))) == std::vector<int>({9, 7, 3}) );
+        BOOST_CHECK( top_2_by.merge(std::vector<int>({4, 6}), std::vector<int>({5, 3}))                 == std::vector<int>({3, 4}) );
+    }
 BOOST_AUTO_TEST_SUITE_END() //order tests
 
 BOOST_FIXTURE_TEST_SUITE(set_tests, test_fixture)
@@ -596,8 +1382,160 @@ BOOST_FIXTURE_TEST_SUITE(set_tests, test_fixture)
         BOOST_CHECK( join_obj(ordered_ints)  == std::vector<int>({1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 4, 4}) );
         BOOST_CHECK( join_obj(empty_int_vec) == std::vector<int>({4, 4}) );
     }
+
+    BOOST_AUTO_TEST_CASE(set_difference_test)
+    {
+        auto set_difference_obj = set_difference(std::vector<int>({4, 0, 2, 4}));
+        auto sorted_difference_obj = set_difference(std::vector<int>({0, 2, 4, 4}), sorted);
+        BOOST_CHECK( set_difference_obj(std::vector<int>({1, 2, 2, 3, 4, 1}))    == std::vector<int>({1, 3}) );
+        BOOST_CHECK( set_difference_obj(unordered_ints).size()                    == 8 );
+        BOOST_CHECK( set_difference_obj(int_vec)                                  == std::vector<int>({5}) );
+        BOOST_CHECK( set_difference_obj(empty_int_vec)                            == empty_int_vec );
+        BOOST_CHECK( sorted_difference_obj(std::vector<int>({1, 1, 2, 3, 4, 5}))  == std::vector<int>({1, 3, 5}) );
+        BOOST_CHECK( sorted_difference_obj(ordered_ints)                          == std::vector<int>({1, 3, 5, 6, 7, 8, 9, 10}) );
+        BOOST_CHECK( sorted_difference_obj(empty_int_vec)                         == empty_int_vec );
+        BOOST_CHECK( set_difference(empty_int_vec)(int_vec)                       == std::vector<int>({5}) );
+    }
+
+    BOOST_AUTO_TEST_CASE(set_intersect_test)
+    {
+        auto set_intersect_obj = set_intersect(std::vector<int>({4, 0, 2, 4}));
+        auto sorted_intersect_obj = set_intersect(std::vector<int>({0, 2, 4, 4}), sorted);
+        auto str_intersect_obj = set_intersect(std::vector<std::string>({"s3   ", "s1 ", "s9"}));
+        BOOST_CHECK( set_intersect_obj(std::vector<int>({1, 4, 2, 2, 3, 4}))     == std::vector<int>({4, 2}) );
+        BOOST_CHECK( set_intersect_obj(unordered_ints).size()                    == 2 );
+        BOOST_CHECK( set_intersect_obj(int_vec)                                  == empty_int_vec );
+        BOOST_CHECK( set_intersect_obj(empty_int_vec)                            == empty_int_vec );
+        BOOST_CHECK( sorted_intersect_obj(std::vector<int>({1, 2, 2, 3, 4, 4}))  == std::vector<int>({2, 4}) );
+        BOOST_CHECK( sorted_intersect_obj(ordered_ints)                          == std::vector<int>({2, 4}) );
+        BOOST_CHECK( sorted_intersect_obj(empty_int_vec)                         == empty_int_vec );
+        BOOST_CHECK( str_intersect_obj(string_vec)                               == std::vector<std::string>({"s1 ", "s3   "}) );
+    }
+
+    BOOST_AUTO_TEST_CASE(set_union_test)
+    {
+        auto set_union_obj = set_union(std::vector<int>({4, 0, 2, 4}));
+        auto sorted_union_obj = set_union(std::vector<int>({0, 2, 4, 4}), sorted);
+        BOOST_CHECK( set_union_obj(std::vector<int>({1, 2, 2, 3}))           == std::vector<int>({1, 2, 3, 4, 0}) );
+        BOOST_CHECK( set_union_obj(int_vec)                                  == std::vector<int>({5, 4, 0, 2}) );
+        BOOST_CHECK( set_union_obj(empty_int_vec)                            == std::vector<int>({4, 0, 2}) );
+        BOOST_CHECK( sorted_union_obj(std::vector<int>({1, 2, 2, 3, 5, 5}))  == std::vector<int>({0, 1, 2, 3, 4, 5}) );
+        BOOST_CHECK( sorted_union_obj(ordered_ints)                          == std::vector<int>({0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10}) );
+        BOOST_CHECK( sorted_union_obj(empty_int_vec)                         == std::vector<int>({0, 2, 4}) );
+    }
 BOOST_AUTO_TEST_SUITE_END() //set tests
 
+BOOST_FIXTURE_TEST_SUITE(window_tests, test_fixture)
+    BOOST_AUTO_TEST_CASE(window_test)
+    {
+        std::default_random_engine engine(23);
+        std::uniform_int_distribution<int> int_dist(-50, 50);
+
+        std::vector<int> random_ints(500);
+        for(size_t i = 0; i < random_ints.size(); ++i)
+        {
+            random_ints[i] = int_dist(engine);
+        }
+
+        const size_t w = 7;
+        std::vector<int> expected_sum, expected_min, expected_max, expected_fold;
+        std::vector<double> expected_avg;
+        std::vector<std::ptrdiff_t> expected_count;
+        for(size_t i = 0; i + w <= random_ints.size(); ++i)
+        {
+            std::vector<int> sub(random_ints.begin() + i, random_ints.begin() + i + w);
+            expected_sum.push_back(sum()(sub));
+            expected_min.push_back(min()(sub));
+            expected_max.push_back(max()(sub));
+            expected_avg.push_back(avg()(sub));
+            expected_count.push_back(count(0)(sub));
+            expected_fold.push_back(fold(std::minus<int>(), 0)(sub));
+        }
+
+        auto window_sum = window(w, sum());
+        auto window_min = window(w, min());
+        auto window_max = window(w, max());
+        auto window_avg = window(w, avg());
+        auto window_count = window(w, count(0));
+        auto window_size = window(3, size());
+        auto window_fold = window(w, fold(std::minus<int>(), 0));
+        auto where_window = make_stp(where([](int i){return i % 2 == 0;}), window(2, sum()));
+
+        BOOST_CHECK( window_sum(random_ints)    == expected_sum );
+        BOOST_CHECK( window_min(random_ints)    == expected_min );
+        BOOST_CHECK( window_max(random_ints)    == expected_max );
+        BOOST_CHECK( window_avg(random_ints)    == expected_avg );
+        BOOST_CHECK( window_count(random_ints)  == expected_count );
+        BOOST_CHECK( window_fold(random_ints)   == expected_fold );
+        BOOST_CHECK( window_size(ordered_ints)  == std::vector<std::ptrdiff_t>(8, 3) );
+        BOOST_CHECK( where_window(ordered_ints) == std::vector<int>({6, 10, 14, 18}) );
+        BOOST_CHECK( window_sum(std::vector<int>({1, 2})).empty() );
+
+        auto window_distinct = make_stp(window(4, approx_distinct()), map([](double i){return std::round(i);}));
+        BOOST_CHECK( window_distinct(std::vector<int>({1, 1, 2, 3, 3})) == std::vector<double>({3.0, 3.0}) );
+
+        auto window_median = window(3, quantiles({0.5}, exact));
+        BOOST_CHECK( window_median(std::vector<int>({1, 5, 2, 4, 3})) == std::vector<std::vector<double>>({{2.0}, {4.0}, {3.0}}) );
+
+        //A large element must not leave its rounding error in later windows
+        std::vector<double> large_then_small({1e20, 1, 1, 1, 1});
+        BOOST_CHECK( window(3, sum())(large_then_small) == std::vector<double>({1e20, 3, 3}) );
+        BOOST_CHECK( window(3, avg())(large_then_small) == std::vector<double>({1e20 / 3, 1, 1}) );
+
+        auto window_top = window(3, top_k(2));
+        BOOST_CHECK( window_top(std::vector<int>({1, 5, 2, 4, 3})) == std::vector<std::vector<int>>({{5, 2}, {5, 4}, {4, 3}}) );
+
+        auto stream = window(3, max()).state<int>();
+        BOOST_CHECK( stream.push(5)   == false );
+        BOOST_CHECK( stream.push(1)   == false );
+        BOOST_CHECK( stream.push(2)   == true );
+        BOOST_CHECK( stream.result()  == 5 );
+        BOOST_CHECK( stream.push(0)   == true );
+        BOOST_CHECK( stream.result()  == 2 );
+
+        BOOST_CHECK_THROW( window(0, sum()), std::invalid_argument );
+    }
+
+    BOOST_AUTO_TEST_CASE(time_window_test)
+    {
+        using event = std::pair<long, int>;
+        using result = std::vector<std::pair<long, int>>;
+
+        std::vector<event> events({{0, 1}, {3, 2}, {9, 3}, {10, 4}, {12, 5}, {11, 9}, {7, 6}, {25, 7}, {-4, 8}});
+
+        auto time = [](const event &i){return i.first;};
+        auto value = [](const event &i){return i.second;};
+
+        auto tumbling = make_stp(time_window(time, 10L, fold([&](int acc, const event &i){return acc + value(i);}, 0)));
+        auto hopping = make_stp(time_window(time, 10L, 5L, size()));
+
+        //{11, 9} is late but its window is still open, {7, 6} and {-4, 8} arrive after their windows were emitted
+        BOOST_CHECK( tumbling(events) == result({{0, 6}, {10, 18}, {20, 7}}) );
+
+        BOOST_CHECK( hopping(events)  == (std::vector<std::pair<long, std::ptrdiff_t>>({{-5, 2}, {0, 3}, {5, 5}, {10, 3}, {20, 1}, {25, 1}})) );
+
+        std::vector<std::pair<double, int>> real_events({{0.25, 1}, {0.75, 2}, {1.5, 3}});
+        auto real_window = time_window([](const std::pair<double, int> &i){return i.first;}, 0.5, fold([](int acc, const std::pair<double, int> &i){return acc + i.second;}, 0));
+        BOOST_CHECK( real_window(real_events) == (std::vector<std::pair<double, int>>({{0.0, 1}, {0.5, 2}, {1.5, 3}})) );
+
+        auto stream = time_window([](int i){return i;}, 10, 2, sum()).state<int>();
+        size_t emitted = 0;
+        size_t max_open = 0;
+        for(int i = 0; i < 1000; ++i)
+        {
+            emitted += stream.push(i).size();
+            max_open = std::max(max_open, stream.open_windows());
+        }
+
+        BOOST_CHECK( emitted  == 499 );
+        BOOST_CHECK( max_open == 5 );
+        BOOST_CHECK( stream.flush().size() == 5 );
+
+        BOOST_CHECK_THROW( time_window(time, 0L, sum()), std::invalid_argument );
+        BOOST_CHECK_THROW( time_window(time, 10L, -1L, sum()), std::invalid_argument );
+    }
+BOOST_AUTO_TEST_SUITE_END() //window tests
+
 BOOST_FIXTURE_TEST_SUITE(stp_tests, test_fixture)
     BOOST_AUTO_TEST_CASE(stp_level1_test)
     {
@@ -804,4 +1742,181 @@ BOOST_FIXTURE_TEST_SUITE(stp_tests, test_fixture)
         auto zip_map_sum = make_stp(zip(range(10, 0)), map([](const std::pair<int, int> &i){return i.first + i.second;}), sum());
         BOOST_CHECK( zip_map_sum(ordered_ints) == 110 );
     }
+    BOOST_AUTO_TEST_CASE(incremental_test)
+    {
+        auto even_square_sum = make_incremental<std::vector<int>>(where([](int i){return i % 2 == 0;}), map([](int i){return i * i;}), sum());
+        auto incremental_min = make_incremental<std::vector<int>>(min());
+        auto incremental_fold = make_incremental<std::vector<int>>(map([](int i){return i + 1;}), fold([](int a, int b){return a * b;}, 1));
+        auto incremental_any = make_incremental<std::vector<int>>(any([](int i){return i > 10;}));
+
+        std::vector<int> values({1, 2, 3, 4});
+        BOOST_CHECK( even_square_sum(values) == 20 );
+        BOOST_CHECK( incremental_min(values) == 1 );
+        BOOST_CHECK( incremental_fold(values) == 120 );
+        BOOST_CHECK( !incremental_any(values) );
+        BOOST_CHECK( even_square_sum.processed() == 4 );
+
+        values.push_back(6);
+        values.push_back(0);
+        values.push_back(11);
+        BOOST_CHECK( even_square_sum(values) == 56 );
+        BOOST_CHECK( incremental_min(values) == 0 );
+        BOOST_CHECK( incremental_fold(values) == 120 * 7 * 1 * 12 );
+        BOOST_CHECK( incremental_any(values) );
+        BOOST_CHECK( even_square_sum.processed() == 7 );
+        BOOST_CHECK( even_square_sum(values) == 56 );
+
+        std::vector<int> other({2, 2});
+        BOOST_CHECK( even_square_sum(other) == 8 );
+
+        other.pop_back();
+        BOOST_CHECK( even_square_sum(other) == 4 );
+        BOOST_CHECK( even_square_sum.processed() == 1 );
+
+        other[0] = 4;
+        even_square_sum.reset();
+        BOOST_CHECK( even_square_sum(other) == 16 );
+
+        std::vector<int> empty_vec;
+        BOOST_CHECK_THROW( incremental_min(empty_vec), std::range_error );
+    }
+    BOOST_AUTO_TEST_CASE(memoize_test)
+    {
+        int evaluations = 0;
+        auto counted_sum = make_stp(map([&](int i){++evaluations; return i;}), sum());
+        auto memo_sum = memoize<std::vector<int>>(counted_sum, 2);
+
+        std::vector<int> values({1, 2, 3});
+        BOOST_CHECK( memo_sum(values, 0) == 6 );
+        BOOST_CHECK( memo_sum(values, 0) == 6 );
+        BOOST_CHECK( evaluations == 3 );
+
+        values.push_back(4);
+        BOOST_CHECK( memo_sum(values, 1) == 10 );
+        BOOST_CHECK( evaluations == 7 );
+
+        evaluations = 0;
+        std::vector<int> copy(values);
+        BOOST_CHECK( memo_sum(values) == 10 );
+        BOOST_CHECK( memo_sum(copy) == 10 );
+        BOOST_CHECK( evaluations == 4 );
+        BOOST_CHECK( memo_sum.size() == 2 );
+
+        auto shared_memo = memo_sum;
+        BOOST_CHECK( shared_memo(copy) == 10 );
+        BOOST_CHECK( evaluations == 4 );
+
+        BOOST_CHECK( memo_sum(values, 0) == 10 );
+        BOOST_CHECK( evaluations == 8 );
+        BOOST_CHECK( memo_sum.size() == 2 );
+
+        copy.push_back(5);
+        BOOST_CHECK( memo_sum(copy) == 15 );
+        BOOST_CHECK( evaluations == 13 );
+
+        memo_sum.clear();
+        BOOST_CHECK( shared_memo.size() == 0 );
+
+        BOOST_CHECK_THROW( memoize<std::vector<int>>(counted_sum, 0), std::invalid_argument );
+    }
+    BOOST_AUTO_TEST_CASE(staged_test)
+    {
+        std::vector<int> values = range(0, 10000);
+
+        auto staged_sum = make_staged<std::vector<int>>(16, 2, where([](int i){return i % 3 != 0;}), map([](int i){return static_cast<long long>(i) * i;}), sum());
+        auto staged_fold = make_staged<std::vector<int>>(3, 1, map([](int i){return i % 10;}), fold([](long long a, int b){return (a * 7 + b) % 1000003;}, 0LL));
+        auto staged_count = make_staged<std::vector<int>>(4, 4, size());
+        auto staged_throw = make_staged<std::vector<int>>(8, 1, map([](int i){if(i == 5000) throw std::runtime_error("Stage failed"); return i;}), where([](int){return true;}), sum());
+
+        long long expected_sum = 0;
+        long long expected_fold = 0;
+        for(int i : values)
+        {
+            expected_sum += i % 3 != 0 ? static_cast<long long>(i) * i : 0;
+            expected_fold = (expected_fold * 7 + i % 10) % 1000003;
+        }
+
+        BOOST_CHECK( staged_sum(values)   == expected_sum );
+        BOOST_CHECK( staged_fold(values)  == expected_fold );
+        BOOST_CHECK( staged_count(values) == 10000 );
+        BOOST_CHECK( staged_sum(empty_int_vec) == 0 );
+
+        BOOST_CHECK( staged_sum(values) == expected_sum );
+        BOOST_CHECK( staged_sum.stats().size() == 2 );
+        BOOST_CHECK( staged_sum.stats()[0].capacity == 2 );
+        BOOST_CHECK( staged_sum.stats()[0].batches == (6666 + 15) / 16 );
+        BOOST_CHECK( staged_sum.stats()[0].max_occupancy <= 2 );
+        BOOST_CHECK( staged_count.stats().empty() );
+
+        BOOST_CHECK_THROW( staged_throw(values), std::runtime_error );
+        BOOST_CHECK_THROW( make_staged<std::vector<int>>(0, 1, sum()), std::invalid_argument );
+    }
+    BOOST_AUTO_TEST_CASE(thread_pool_test)
+    {
+        detail::thread_pool pool(3, std::vector<unsigned int>({0}));
+        BOOST_CHECK( pool.workers() == 3 );
+
+        std::atomic<int> counter(0);
+        detail::task_group group(pool);
+        for(int i = 0; i < 1000; ++i)
+        {
+            group.run([&counter](){++counter;});
+        }
+        group.wait();
+        BOOST_CHECK( counter.load() == 1000 );
+
+        //Nested groups wait by running queued tasks, so more nested waits than workers cannot deadlock
+        std::atomic<int> nested(0);
+        detail::parallel_for(pool, 16, [&](const std::size_t &)
+        {
+            detail::parallel_for(pool, 16, [&](const std::size_t &)
+            {
+                ++nested;
+            });
+        });
+        BOOST_CHECK( nested.load() == 256 );
+
+        BOOST_CHECK_THROW( detail::parallel_for(pool, 8, [](const std::size_t &i){if(i == 5) throw std::runtime_error("Task failed");}), std::runtime_error );
+
+        detail::thread_pool empty_pool(0, std::vector<unsigned int>());
+        int sequential = 0;
+        detail::parallel_for(empty_pool, 10, [&](const std::size_t &){++sequential;});
+        BOOST_CHECK( sequential == 10 );
+
+        sort(par)(ordered_ints);
+        BOOST_CHECK_THROW( configure_thread_pool(2), std::logic_error );
+    }
+    BOOST_AUTO_TEST_CASE(projection_test)
+    {
+        struct account
+        {
+            bool is_overdrawn() const
+            {
+                return acct_balance < 0.0;
+            }
+
+            std::string  acct_holder;
+            double       acct_balance;
+            unsigned int acct_id;
+            bool         active;
+        };
+
+        std::vector<account> accts({{"Ben", 1550.4, 103, true}, {"Mary", -240.0, 101, false}, {"Eve", 1200.0, 104, true}, {"Mark", 450.1, 102, true}});
+
+        auto balances = map(&account::acct_balance);
+        auto active_ids = make_stp(where(&account::active), map(&account::acct_id));
+        auto overdrawn_holders = make_stp(where(&account::is_overdrawn), map(&account::acct_holder));
+        auto ids_by_id = make_stp(sort_by(&account::acct_id), map(&account::acct_id));
+        auto richest = make_stp(top_k_by(2, &account::acct_balance), map(&account::acct_holder));
+        auto poorest = make_stp(bottom_k_by(1, &account::acct_balance), map(&account::acct_holder));
+        auto par_active_balance = make_stp(where(par, &account::active), map(par, &account::acct_balance), sum());
+
+        BOOST_CHECK( balances(accts)          == std::vector<double>({1550.4, -240.0, 1200.0, 450.1}) );
+        BOOST_CHECK( active_ids(accts)        == std::vector<unsigned int>({103, 104, 102}) );
+        BOOST_CHECK( overdrawn_holders(accts) == std::vector<std::string>({"Mary"}) );
+        BOOST_CHECK( ids_by_id(accts)         == std::vector<unsigned int>({101, 102, 103, 104}) );
+        BOOST_CHECK( richest(accts)           == std::vector<std::string>({"Ben", "Eve"}) );
+        BOOST_CHECK( poorest(accts)           == std::vector<std::string>({"Mary"}) );
+        BOOST_CHECK( comp_real(par_active_balance(accts), 3200.5, 1e-9) );
+    }
 BOOST_AUTO_TEST_SUITE_END() //stp tests
\ No newline at end of file